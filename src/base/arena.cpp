@@ -0,0 +1,58 @@
+#include "base/arena.h"
+
+#include <stdlib.h>
+
+Arena::Arena(size_t chunk_size)
+    : chunk_size_(chunk_size),
+      cur_(nullptr),
+      end_(nullptr),
+      chunks_(nullptr),
+      destructors_(nullptr),
+      reserved_(0) {}
+
+Arena::~Arena() { Release(); }
+
+void *Arena::AllocSlow(size_t size, size_t align) {
+  size_t header = (sizeof(Chunk) + align - 1) & ~(align - 1);
+  size_t s = header + size;
+  if (s < chunk_size_) {
+    s = chunk_size_;
+  }
+  Chunk *chunk = static_cast<Chunk *>(malloc(s));
+  if (chunk == nullptr) {
+    throw std::bad_alloc();
+  }
+  chunk->next = chunks_;
+  chunks_ = chunk;
+  reserved_ += s;
+  char *p = reinterpret_cast<char *>(chunk) + header;
+  cur_ = p + size;
+  end_ = reinterpret_cast<char *>(chunk) + s;
+  return p;
+}
+
+void Arena::AddDestructor(void *obj, void (*fn)(void *obj)) {
+  Destructor *d = static_cast<Destructor *>(
+      Alloc(sizeof(Destructor), alignof(Destructor)));
+  d->fn = fn;
+  d->obj = obj;
+  d->next = destructors_;
+  destructors_ = d;
+}
+
+void Arena::Release() {
+  for (Destructor *d = destructors_; d != nullptr; d = d->next) {
+    d->fn(d->obj);
+  }
+  destructors_ = nullptr;
+  while (chunks_ != nullptr) {
+    Chunk *next = chunks_->next;
+    free(chunks_);
+    chunks_ = next;
+  }
+  cur_ = nullptr;
+  end_ = nullptr;
+  reserved_ = 0;
+}
+
+size_t Arena::GetReservedSize() const { return reserved_; }
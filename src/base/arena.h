@@ -0,0 +1,72 @@
+// -*- C++ -*-
+#ifndef _base_arena_h_
+#define _base_arena_h_
+
+#include <stddef.h>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bump pointer allocator.
+//
+// Objects are placed contiguously in allocation order and the chunks are
+// freed together by Release(). Destructors of objects which have one run
+// in the reverse order of the allocation. Objects can't be freed one by one.
+class Arena {
+ public:
+  // Chunks are at least chunk_size bytes.
+  explicit Arena(size_t chunk_size = 64 * 1024);
+  ~Arena();
+
+  template <class T, class... Args>
+  T *New(Args &&... args) {
+    void *p = Alloc(sizeof(T), alignof(T));
+    T *obj = new (p) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+      AddDestructor(obj, &Destroy<T>);
+    }
+    return obj;
+  }
+
+  void *Alloc(size_t size, size_t align) {
+    size_t pad = (align - ((size_t)cur_ & (align - 1))) & (align - 1);
+    if (cur_ == nullptr || pad + size > (size_t)(end_ - cur_)) {
+      return AllocSlow(size, align);
+    }
+    char *p = cur_ + pad;
+    cur_ = p + size;
+    return p;
+  }
+
+  void Release();
+  // Bytes of the chunks.
+  size_t GetReservedSize() const;
+
+ private:
+  struct Chunk {
+    Chunk *next;
+  };
+  struct Destructor {
+    void (*fn)(void *obj);
+    void *obj;
+    Destructor *next;
+  };
+
+  template <class T>
+  static void Destroy(void *obj) {
+    static_cast<T *>(obj)->~T();
+  }
+
+  void *AllocSlow(size_t size, size_t align);
+  void AddDestructor(void *obj, void (*fn)(void *obj));
+
+  size_t chunk_size_;
+  char *cur_;
+  char *end_;
+  Chunk *chunks_;
+  Destructor *destructors_;
+  size_t reserved_;
+};
+
+#endif  // _base_arena_h_
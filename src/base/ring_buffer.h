@@ -0,0 +1,106 @@
+// -*- C++ -*-
+#ifndef _base_ring_buffer_h_
+#define _base_ring_buffer_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+// Fixed capacity MPMC queue without locks.
+//
+// Each cell has a sequence number telling whether it is ready to be
+// pushed (== position) or popped (== position + 1) at the position.
+// Producers and consumers claim a position with a CAS on the tail or
+// the head. Positions are 64 bits, so they don't wrap around.
+//
+// The sequence numbers can't tell a full cell from an empty one with
+// only 1 cell, so there are at least 2 cells and Push() checks the
+// capacity against the head.
+template <class T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(size_t capacity)
+      : capacity_(capacity > 0 ? capacity : 1),
+        num_cells_(capacity_ > 1 ? capacity_ : 2),
+        cells_(num_cells_),
+        head_(0),
+        tail_(0) {
+    for (size_t i = 0; i < num_cells_; ++i) {
+      cells_[i].seq_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false if full.
+  bool Push(const T &value) {
+    uint64_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      uint64_t head = head_.load(std::memory_order_acquire);
+      if ((int64_t)(pos - head) >= (int64_t)capacity_) {
+        return false;
+      }
+      Cell &cell = cells_[pos % num_cells_];
+      uint64_t seq = cell.seq_.load(std::memory_order_acquire);
+      int64_t diff = (int64_t)seq - (int64_t)pos;
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          cell.value_ = value;
+          cell.seq_.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false if empty.
+  bool Pop(T *value) {
+    uint64_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos % num_cells_];
+      uint64_t seq = cell.seq_.load(std::memory_order_acquire);
+      int64_t diff = (int64_t)seq - (int64_t)(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          *value = cell.value_;
+          cell.seq_.store(pos + num_cells_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Approximate while other threads are pushing or popping.
+  size_t Size() const {
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    return (tail > head) ? (size_t)(tail - head) : 0;
+  }
+
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  struct Cell {
+    std::atomic<uint64_t> seq_;
+    T value_;
+  };
+
+  const size_t capacity_;
+  const size_t num_cells_;
+  std::vector<Cell> cells_;
+  // On different cache lines for producers and consumers.
+  alignas(64) std::atomic<uint64_t> head_;
+  alignas(64) std::atomic<uint64_t> tail_;
+};
+
+#endif  // _base_ring_buffer_h_
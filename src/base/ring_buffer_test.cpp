@@ -0,0 +1,99 @@
+#include "base/ring_buffer.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "iroha/test_util.h"
+
+static void TestSingleProducer() {
+  // Capacity 1 needs a special care. See RingBuffer.
+  for (int capacity = 1; capacity <= 3; ++capacity) {
+    RingBuffer<int> rb(capacity);
+    ASSERT(rb.Capacity() == capacity);
+    int v;
+    ASSERT(!rb.Pop(&v));
+    for (int round = 0; round < 5; ++round) {
+      for (int i = 0; i < capacity; ++i) {
+        ASSERT(rb.Push(round * 10 + i));
+      }
+      ASSERT(rb.Size() == capacity);
+      ASSERT(!rb.Push(-1));
+      for (int i = 0; i < capacity; ++i) {
+        ASSERT(rb.Pop(&v));
+        ASSERT(v == round * 10 + i);
+      }
+      ASSERT(rb.Size() == 0);
+      ASSERT(!rb.Pop(&v));
+    }
+  }
+  // Interleaved.
+  RingBuffer<int> rb(2);
+  int v;
+  ASSERT(rb.Push(1));
+  ASSERT(rb.Pop(&v) && v == 1);
+  ASSERT(rb.Push(2));
+  ASSERT(rb.Push(3));
+  ASSERT(!rb.Push(4));
+  ASSERT(rb.Pop(&v) && v == 2);
+  ASSERT(rb.Push(4));
+  ASSERT(rb.Pop(&v) && v == 3);
+  ASSERT(rb.Pop(&v) && v == 4);
+}
+
+static void TestMultiProducer() {
+  const int kNumProducers = 4;
+  const int kNumConsumers = 2;
+  const int kNumValues = 20000;
+  RingBuffer<int> rb(8);
+  std::vector<std::vector<int> > popped(kNumConsumers);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kNumProducers; ++p) {
+    threads.push_back(std::thread([p, &rb]() {
+      for (int i = 0; i < kNumValues; ++i) {
+        while (!rb.Push(p * kNumValues + i)) {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+  for (int c = 0; c < kNumConsumers; ++c) {
+    threads.push_back(std::thread([c, &rb, &popped]() {
+      int n = kNumProducers * kNumValues / kNumConsumers;
+      while (popped[c].size() < n) {
+        int v;
+        if (rb.Pop(&v)) {
+          popped[c].push_back(v);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+  for (std::thread &th : threads) {
+    th.join();
+  }
+  std::vector<int> all;
+  for (int c = 0; c < kNumConsumers; ++c) {
+    // Values from a producer are popped in the order of pushes.
+    std::vector<int> last(kNumProducers, -1);
+    for (int v : popped[c]) {
+      int p = v / kNumValues;
+      ASSERT(v > last[p]);
+      last[p] = v;
+    }
+    all.insert(all.end(), popped[c].begin(), popped[c].end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT(all.size() == kNumProducers * kNumValues);
+  for (int i = 0; i < all.size(); ++i) {
+    ASSERT(all[i] == i);
+  }
+  int v;
+  ASSERT(!rb.Pop(&v));
+}
+
+void TestRingBuffer() {
+  TestSingleProducer();
+  TestMultiProducer();
+}
@@ -1,39 +1,64 @@
 #include "base/sym.h"
 
 #include <alloca.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <list>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
-#include "base/stl_util.h"
+using std::vector;
 
-using std::list;
-
-#define BUCKET_COUNT 32
-
-static int tmp_idx;
+static std::atomic<int> tmp_idx;
 
 class sym {
  public:
-  sym(const char *n);
+  sym(const char *n, size_t len, uint64_t hash);
   ~sym();
-  int hash(void);
+  uint64_t hash(void);
   const char *str(void);
+  bool equals(const char *n, size_t len);
 
  private:
   char *str_;
-  int hash_;
+  size_t len_;
+  uint64_t hash_;
 };
 
+// Open addressing table with linear probing.
+//
+// Lookups of existing syms don't take the lock. A slot changes only once
+// from nullptr to a sym, and a grown table is published after all syms are
+// copied, so a reader sees either a complete old table or the new one.
+// Old tables are kept until the end since readers may still probe them.
 class SymTable {
  public:
+  SymTable();
   ~SymTable();
-  sym *lookup(const char *str);
+  sym *lookup(const char *str, size_t len);
 
  private:
-  list<sym *> buckets_[BUCKET_COUNT];
+  struct Table {
+    explicit Table(size_t size);
+
+    // Power of 2.
+    size_t mask_;
+    std::unique_ptr<std::atomic<sym *>[]> slots_;
+  };
+
+  static sym *find(Table *t, const char *str, size_t len, uint64_t h);
+  void insert(Table *t, sym *s);
+  void grow();
+
+  std::atomic<Table *> table_;
+  // Accessed with mu_.
+  std::mutex mu_;
+  vector<Table *> tables_;
+  vector<sym *> syms_;
 } SymTable;
 
 sym_t sym_null, sym_string;
@@ -44,54 +69,123 @@ sym_t sym_break, sym_continue, sym_goto;
 sym_t sym_int, sym_bool, sym_object, sym_module;
 sym_t sym_output, sym_input, sym_parent;
 
-static int str_hash(const char *str) {
-  int h = 0;
-  while (*str) {
-    h += (*str * 1003);
-    str++;
+// FNV-1a (64 bits) with a final mix, since the lower bits select the slot
+// and tmp syms differ only in the last few chars.
+static uint64_t str_hash(const char *str, size_t len) {
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; ++i) {
+    h ^= (unsigned char)str[i];
+    h *= 1099511628211ULL;
   }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
   return h;
 }
 
-sym::sym(const char *n) {
-  str_ = strdup(n);
-  hash_ = str_hash(n);
+sym::sym(const char *n, size_t len, uint64_t hash) : len_(len), hash_(hash) {
+  str_ = strndup(n, len);
 }
 
 sym::~sym() { free(str_); }
 
-int sym::hash(void) { return hash_; }
+uint64_t sym::hash(void) { return hash_; }
 
 const char *sym::str(void) { return str_; }
 
-sym *SymTable::lookup(const char *str) {
-  if (!str) {
-    return sym_null;
+bool sym::equals(const char *n, size_t len) {
+  return len == len_ && !memcmp(str_, n, len);
+}
+
+SymTable::Table::Table(size_t size)
+    : mask_(size - 1), slots_(new std::atomic<sym *>[size]) {
+  for (size_t i = 0; i < size; ++i) {
+    slots_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+SymTable::SymTable() {
+  Table *t = new Table(1024);
+  tables_.push_back(t);
+  table_.store(t, std::memory_order_release);
+}
+
+SymTable::~SymTable() {
+  for (sym *s : syms_) {
+    delete s;
   }
-  int h = str_hash(str);
-  int b = h % BUCKET_COUNT;
+  for (Table *t : tables_) {
+    delete t;
+  }
+}
 
-  for (sym *s : buckets_[b]) {
-    if (h != s->hash()) {
-      continue;
+sym *SymTable::find(Table *t, const char *str, size_t len, uint64_t h) {
+  for (size_t i = h & t->mask_;; i = (i + 1) & t->mask_) {
+    sym *s = t->slots_[i].load(std::memory_order_acquire);
+    if (s == nullptr) {
+      return nullptr;
     }
-    if (!strcmp(s->str(), str)) {
+    if (s->hash() == h && s->equals(str, len)) {
       return s;
     }
   }
-  // could not find
-  sym *s = new sym(str);
-  buckets_[b].push_back(s);
+}
+
+void SymTable::insert(Table *t, sym *s) {
+  size_t i = s->hash() & t->mask_;
+  while (t->slots_[i].load(std::memory_order_relaxed) != nullptr) {
+    i = (i + 1) & t->mask_;
+  }
+  t->slots_[i].store(s, std::memory_order_release);
+}
+
+void SymTable::grow() {
+  size_t size = table_.load(std::memory_order_relaxed)->mask_ + 1;
+  Table *t = new Table(size * 2);
+  for (sym *s : syms_) {
+    insert(t, s);
+  }
+  tables_.push_back(t);
+  table_.store(t, std::memory_order_release);
+}
+
+sym *SymTable::lookup(const char *str, size_t len) {
+  if (!str) {
+    return sym_null;
+  }
+  uint64_t h = str_hash(str, len);
+  sym *s = find(table_.load(std::memory_order_acquire), str, len, h);
+  if (s != nullptr) {
+    return s;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  // Another thread might have added it or grown the table.
+  Table *t = table_.load(std::memory_order_relaxed);
+  s = find(t, str, len, h);
+  if (s != nullptr) {
+    return s;
+  }
+  s = new sym(str, len, h);
+  syms_.push_back(s);
+  // Keeps the load factor under 1/2.
+  if (syms_.size() * 2 > t->mask_ + 1) {
+    grow();
+  } else {
+    insert(t, s);
+  }
   return s;
 }
 
-SymTable::~SymTable() {
-  for (int i = 0; i < BUCKET_COUNT; ++i) {
-    STLDeleteValues(&buckets_[i]);
+sym_t sym_lookup(const char *str) {
+  if (!str) {
+    return sym_null;
   }
+  return SymTable.lookup(str, strlen(str));
 }
 
-sym_t sym_lookup(const char *str) { return SymTable.lookup(str); }
+sym_t sym_lookup(const char *str, size_t len) {
+  return SymTable.lookup(str, len);
+}
 
 const char *sym_cstr(const sym_t s) {
   if (s == sym_null) {
@@ -104,8 +198,8 @@ std::string sym_str(const sym_t s) { return std::string(sym_cstr(s)); }
 
 sym_t sym_alloc_tmp_sym(const char *suffix) {
   char buf[128];
-  tmp_idx++;
-  sprintf(buf, "_t%s_%d", suffix, tmp_idx);
+  int idx = ++tmp_idx;
+  sprintf(buf, "_t%s_%d", suffix, idx);
   return sym_lookup(buf);
 }
 
@@ -6,7 +6,10 @@
 
 typedef class sym *sym_t;
 void sym_table_init();
+// Functions below can be called from multiple threads.
 sym_t sym_lookup(const char *str);
+// str doesn't have to be terminated.
+sym_t sym_lookup(const char *str, size_t len);
 const char *sym_cstr(const sym_t s);
 std::string sym_str(const sym_t s);
 sym_t sym_alloc_tmp_sym(const char *suffix);
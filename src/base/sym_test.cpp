@@ -0,0 +1,52 @@
+#include "base/sym.h"
+
+#include <string.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "iroha/test_util.h"
+
+void TestSymTable() {
+  // Enough to grow the table a few times.
+  std::vector<sym_t> syms;
+  for (int i = 0; i < 20000; ++i) {
+    syms.push_back(sym_append_idx(sym_lookup("reg"), i));
+  }
+  std::set<sym_t> uniq(syms.begin(), syms.end());
+  ASSERT(uniq.size() == syms.size());
+  for (int i = 0; i < 20000; ++i) {
+    ASSERT(sym_append_idx(sym_lookup("reg"), i) == syms[i]);
+  }
+  // Anagrams.
+  ASSERT(sym_lookup("ab") != sym_lookup("ba"));
+  // Not terminated.
+  const char *s = "reg_10xyz";
+  ASSERT(sym_lookup(s, 6) == syms[10]);
+  ASSERT(sym_lookup(s, 3) == sym_lookup("reg"));
+  ASSERT(!strcmp(sym_cstr(sym_lookup(s, 0)), ""));
+
+  // Concurrent lookups and tmp syms.
+  const int kNumThreads = 4;
+  std::vector<std::vector<sym_t> > found(kNumThreads);
+  std::vector<std::vector<sym_t> > tmps(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.push_back(std::thread([t, &found, &tmps]() {
+      for (int i = 0; i < 20000; ++i) {
+        found[t].push_back(sym_append_idx(sym_lookup("wire"), i));
+        tmps[t].push_back(sym_alloc_tmp_sym("_test"));
+      }
+    }));
+  }
+  for (std::thread &th : threads) {
+    th.join();
+  }
+  std::set<sym_t> all_tmps;
+  for (int t = 0; t < kNumThreads; ++t) {
+    ASSERT(found[t] == found[0]);
+    all_tmps.insert(tmps[t].begin(), tmps[t].end());
+  }
+  ASSERT(all_tmps.size() == kNumThreads * 20000);
+}
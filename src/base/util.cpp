@@ -1,5 +1,6 @@
 #include "base/util.h"
 
+#include <stdio.h>
 #include <string.h>
 
 #include <fstream>
@@ -127,3 +128,17 @@ uint64_t Util::RoundUp2(uint64_t x) {
   }
   return 0;
 }
+
+string Util::HashString(const string &s) {
+  // 2 FNV-1a 64 hashes with different offsets.
+  uint64_t h0 = 14695981039346656037ULL;
+  uint64_t h1 = 14695981039346656037ULL ^ s.size();
+  for (unsigned char c : s) {
+    h0 = (h0 ^ c) * 1099511628211ULL;
+    h1 = (h1 * 1099511628211ULL) ^ c;
+  }
+  char buf[40];
+  sprintf(buf, "%016llx%016llx", (unsigned long long)h0,
+          (unsigned long long)h1);
+  return string(buf);
+}
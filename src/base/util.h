@@ -21,6 +21,8 @@ class Util {
   // 0,1,2,3,4 -> 0,0,1,2,2
   static int Log2(int x);
   static uint64_t RoundUp2(uint64_t x);
+  // 128 bits content hash in 32 hex digits. Not cryptographic.
+  static string HashString(const string &s);
 };
 
 #endif  // _base_util_h_
@@ -81,7 +81,7 @@ RegisterTuple ExprCompiler::CompileExpr(fe::Expr *expr) {
 
 vm::Register *ExprCompiler::CompileSimpleExpr(fe::Expr *expr) {
   vm::Register *dst_reg = compiler_->AllocRegister();
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   vm::OpCode op = GetOpCodeFromExpr(expr);
   insn->op_ = MayRewriteToOpWithType(op);
   insn->insn_expr_ = expr;
@@ -179,7 +179,7 @@ vm::Value::ValueType ExprCompiler::GetVariableType(sym_t name) {
 vm::Register *ExprCompiler::CompileArrayRef(fe::Expr *expr) {
   vector<vm::Register *> indexes;
   fe::Expr *array_expr = ResolveArray(expr, &indexes);
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   insn->op_ = vm::OP_ARRAY_READ;
   insn->src_regs_ = indexes;
   insn->insn_expr_ = array_expr;
@@ -305,7 +305,7 @@ vm::Register *ExprCompiler::CompileTriTerm(fe::Expr *expr) {
   vm::Register *cond = CompileExprToOneReg(expr->GetArgs());
   vm::Register *res = compiler_->AllocRegister();
   sym_t f_label = sym_alloc_tmp_sym("_f");
-  vm::Insn *if_insn = new vm::Insn;
+  vm::Insn *if_insn = compiler_->NewInsn();
   if_insn->op_ = vm::OP_IF;
   if_insn->src_regs_.push_back(cond);
   if_insn->label_ = f_label;
@@ -315,7 +315,7 @@ vm::Register *ExprCompiler::CompileTriTerm(fe::Expr *expr) {
   compiler_->SimpleAssign(lhs, res);
   // Go to join.
   sym_t join_label = sym_alloc_tmp_sym("_join");
-  vm::Insn *jump_insn = new vm::Insn;
+  vm::Insn *jump_insn = compiler_->NewInsn();
   jump_insn->op_ = vm::OP_GOTO;
   jump_insn->label_ = join_label;
   compiler_->EmitInsn(jump_insn);
@@ -362,7 +362,7 @@ RegisterTuple ExprCompiler::CompileFuncallExpr(vm::Register *obj_reg,
 RegisterTuple ExprCompiler::CompileMultiValueFuncall(vm::Register *obj_reg,
                                                      fe::Expr *funcall,
                                                      int num_lhs) {
-  vm::Insn *call_insn = new vm::Insn;
+  vm::Insn *call_insn = compiler_->NewInsn();
   if (compiler_->IsTopLevel()) {
     call_insn->op_ = vm::OP_TL_FUNCALL_WITH_CHECK;
   } else {
@@ -424,7 +424,7 @@ RegisterTuple ExprCompiler::CompileMultiValueFuncall(vm::Register *obj_reg,
 RegisterTuple ExprCompiler::EmitFuncallDone(vm::Insn *call_insn,
                                             vm::Method *method, int num_lhs) {
   RegisterTuple rt;
-  vm::Insn *done_insn = new vm::Insn;
+  vm::Insn *done_insn = compiler_->NewInsn();
   if (compiler_->IsTopLevel()) {
     done_insn->op_ = vm::OP_TL_FUNCALL_DONE_WITH_CHECK;
   } else {
@@ -474,7 +474,7 @@ void ExprCompiler::MayEmitTypeDoneInsn(vm::Insn *insn) {
   if (insn->op_ == vm::OP_TL_ADD_MAY_WITH_TYPE ||
       insn->op_ == vm::OP_TL_ADD_MAY_WITH_TYPE ||
       insn->op_ == vm::OP_TL_ADD_MAY_WITH_TYPE) {
-    vm::Insn *done_insn = new vm::Insn;
+    vm::Insn *done_insn = compiler_->NewInsn();
     done_insn->op_ = vm::OP_TL_MAY_WITH_TYPE_DONE;
     done_insn->src_regs_ = insn->src_regs_;
     done_insn->dst_regs_ = insn->dst_regs_;
@@ -520,7 +520,7 @@ RegisterTuple ExprCompiler::CompileAssign(fe::Expr *expr) {
     rhs_reg = UpdateModifyOp(expr->GetType(), expr->GetLhs(), rhs_reg);
   }
 
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   return RegisterTuple(CompileAssignToLhs(insn, expr->GetLhs(), rhs_reg));
 }
 
@@ -663,7 +663,7 @@ vm::Register *ExprCompiler::UpdateModifyOp(fe::NodeCode type,
                                            fe::Expr *lhs_expr,
                                            vm::Register *rhs_reg) {
   vm::Register *lhs_reg = CompileExprToOneReg(lhs_expr);
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   if (type == fe::BINOP_ADD_ASSIGN) {
     insn->op_ = MayRewriteToOpWithType(vm::OP_ADD);
   } else if (type == fe::BINOP_SUB_ASSIGN) {
@@ -718,7 +718,7 @@ vm::Register *ExprCompiler::MayRewriteOperator(vm::Insn *orig_insn) {
     // The operator is not available.
     return nullptr;
   }
-  vm::Insn *call_insn = new vm::Insn;
+  vm::Insn *call_insn = compiler_->NewInsn();
   if (compiler_->IsTopLevel()) {
     call_insn->op_ = vm::OP_TL_FUNCALL_WITH_CHECK;
   } else {
@@ -730,7 +730,7 @@ vm::Register *ExprCompiler::MayRewriteOperator(vm::Insn *orig_insn) {
   call_insn->src_regs_.push_back(orig_insn->src_regs_[1]);
   compiler_->EmitInsn(call_insn);
 
-  vm::Insn *done_insn = new vm::Insn;
+  vm::Insn *done_insn = compiler_->NewInsn();
   if (compiler_->IsTopLevel()) {
     done_insn->op_ = vm::OP_TL_FUNCALL_DONE_WITH_CHECK;
   } else {
@@ -768,7 +768,7 @@ void ExprCompiler::CompileIncDecExpr(fe::Expr *expr) {
     CompileIncDecNonLocal(expr);
     return;
   }
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   if (expr->GetType() == fe::UNIOP_PRE_INC ||
       expr->GetType() == fe::UNIOP_POST_INC) {
     insn->op_ = vm::OP_PRE_INC;
@@ -786,7 +786,7 @@ void ExprCompiler::CompileIncDecNonLocal(fe::Expr *expr) {
   compiler_->SetDelayInsnEmit(false);
   vm::Register *rhs = CompileExprToOneReg(expr->GetArgs());
 
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   insn->op_ = vm::OP_NUM;
   vm::Register *one = compiler_->AllocRegister();
   one->type_.value_type_ = vm::Value::NUM;
@@ -805,7 +805,7 @@ void ExprCompiler::CompileIncDecNonLocal(fe::Expr *expr) {
   dst->type_.num_width_ = rhs->type_.num_width_;
   dst->SetIsDeclaredType(false);
 
-  insn = new vm::Insn;
+  insn = compiler_->NewInsn();
   if (expr->GetType() == fe::UNIOP_PRE_INC ||
       expr->GetType() == fe::UNIOP_POST_INC) {
     insn->op_ = vm::OP_ADD;
@@ -818,7 +818,7 @@ void ExprCompiler::CompileIncDecNonLocal(fe::Expr *expr) {
   insn->src_regs_.push_back(one);
   compiler_->EmitInsn(insn);
 
-  insn = new vm::Insn;
+  insn = compiler_->NewInsn();
   CompileAssignToLhs(insn, expr->GetArgs(), dst);
 
   compiler_->SetDelayInsnEmit(true);
@@ -835,7 +835,7 @@ void ExprCompiler::EmitCompile() {
 }
 
 void ExprCompiler::EmitWriteHdl(const string &fn) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   insn->op_ = vm::OP_STR;
   insn->label_ = sym_lookup(fn.c_str());
   vm::Register *fn_reg = compiler_->AllocRegister();
@@ -851,7 +851,7 @@ void ExprCompiler::EmitWriteHdl(const string &fn) {
 void ExprCompiler::EmitFuncallForEpilogue(const char *name,
                                           vm::Register *obj_reg,
                                           vm::Register *arg_reg) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = compiler_->NewInsn();
   insn->op_ = vm::OP_TL_FUNCALL_WITH_CHECK;
   insn->obj_reg_ = obj_reg;
   insn->label_ = sym_lookup(name);
@@ -0,0 +1,633 @@
+#include "compiler/insn_optimizer.h"
+
+#include "vm/insn.h"
+#include "vm/method.h"
+#include "vm/opcode.h"
+#include "vm/register.h"
+#include "vm/value.h"
+
+namespace compiler {
+
+static uint64_t WidthMask(int w) {
+  if (w >= 64) {
+    return ~0ULL;
+  }
+  return (1ULL << w) - 1;
+}
+
+static int Width(vm::Register *reg) {
+  return reg->type_.num_width_.GetWidth();
+}
+
+static bool IsJump(vm::Insn *insn) {
+  return insn->op_ == vm::OP_IF || insn->op_ == vm::OP_GOTO;
+}
+
+// Ops which can be removed if their results are not used.
+// Array and member reads aren't, since they raise errors for out of range
+// indexes and missing members.
+static bool IsPure(vm::Insn *insn) {
+  switch (insn->op_) {
+    case vm::OP_NUM:
+    case vm::OP_ASSIGN:
+    case vm::OP_LOAD_OBJ:
+    case vm::OP_BIT_RANGE:
+    case vm::OP_PRE_INC:
+    case vm::OP_PRE_DEC:
+      return true;
+    default:
+      break;
+  }
+  return (insn->op_ >= vm::OP_ADD && insn->op_ <= vm::OP_LOGIC_INV &&
+          insn->op_ != vm::OP_ASSIGN && insn->op_ != vm::OP_POST_INC &&
+          insn->op_ != vm::OP_POST_DEC);
+}
+
+// Ops whose result can be written to the destination of the following
+// OP_ASSIGN directly.
+static bool IsCoalescable(vm::Insn *insn) {
+  switch (insn->op_) {
+    case vm::OP_ARRAY_READ:
+    case vm::OP_BIT_RANGE:
+      return true;
+    default:
+      break;
+  }
+  return IsPure(insn) && insn->op_ >= vm::OP_ADD &&
+         insn->op_ != vm::OP_ASSIGN && insn->op_ != vm::OP_PRE_INC &&
+         insn->op_ != vm::OP_PRE_DEC;
+}
+
+// Ops which can take its destination as a source too.
+static bool IsInPlace(vm::Insn *insn) {
+  switch (insn->op_) {
+    case vm::OP_ADD:
+    case vm::OP_SUB:
+    case vm::OP_AND:
+    case vm::OP_OR:
+    case vm::OP_XOR:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+InsnOptimizer::InsnOptimizer(vm::Method *method,
+                             const string &disabled_passes)
+    : method_(method), disabled_passes_(disabled_passes) {}
+
+bool InsnOptimizer::IsPassEnabled(const string &disabled_passes, char pass) {
+  return disabled_passes.find('O') == string::npos &&
+         disabled_passes.find(pass) == string::npos;
+}
+
+void InsnOptimizer::Optimize() {
+  if (!IsOptimizable()) {
+    return;
+  }
+  int num_args = method_->GetNumArgRegisters();
+  int num_rets = method_->GetNumReturnRegisters();
+  for (size_t i = 0; i < method_->method_regs_.size(); ++i) {
+    vm::Register *reg = method_->method_regs_[i];
+    if (i < num_args + num_rets || reg->GetAnnotation() != nullptr) {
+      pinned_.insert(reg);
+    }
+  }
+  struct Pass {
+    char flag;
+    void (InsnOptimizer::*run)();
+  };
+  static const Pass passes[] = {
+      {'F', &InsnOptimizer::FoldConstants},
+      {'L', &InsnOptimizer::EliminateRedundantLoads},
+      {'P', &InsnOptimizer::PropagateCopies},
+      {'D', &InsnOptimizer::EliminateDeadRegisters},
+      {'J', &InsnOptimizer::ThreadJumps},
+  };
+  bool changed = false;
+  for (const Pass &pass : passes) {
+    if (IsPassEnabled(disabled_passes_, pass.flag)) {
+      (this->*pass.run)();
+      changed = true;
+    }
+  }
+  if (changed) {
+    RemoveNops();
+  }
+}
+
+bool InsnOptimizer::IsOptimizable() {
+  for (vm::Insn *insn : method_->insns_) {
+    switch (insn->op_) {
+      case vm::OP_INVALID:
+      case vm::OP_SYM:
+      case vm::OP_ELM_REF:
+      case vm::OP_POST_INC:
+      case vm::OP_POST_DEC:
+        return false;
+      default:
+        break;
+    }
+    if (insn->op_ >= vm::OP_TL_IMPORT) {
+      return false;
+    }
+  }
+  return method_->insns_.size() > 0;
+}
+
+void InsnOptimizer::FoldConstants() {
+  CountRegisters();
+  for (vm::Insn *insn : method_->insns_) {
+    if (insn->op_ == vm::OP_NUM) {
+      vm::Register *reg = insn->dst_regs_[0];
+      if (insn->src_regs_[0] == reg && num_defs_[reg] == 1 &&
+          reg->type_.is_const_ && IsNarrowNum(reg) &&
+          !reg->initial_num_.type_.IsWide()) {
+        const_regs_.insert(reg);
+      }
+      continue;
+    }
+    uint64_t value;
+    if (!FoldInsn(insn, &value)) {
+      continue;
+    }
+    vm::Register *dst = insn->dst_regs_[0];
+    dst->initial_num_.type_ = dst->type_.num_width_;
+    dst->initial_num_.SetValue0(value & WidthMask(Width(dst)));
+    dst->type_.is_const_ = true;
+    dst->SetIsDeclaredType(true);
+    insn->op_ = vm::OP_NUM;
+    insn->src_regs_.clear();
+    insn->src_regs_.push_back(dst);
+    const_regs_.insert(dst);
+  }
+}
+
+bool InsnOptimizer::FoldInsn(vm::Insn *insn, uint64_t *value) {
+  if (insn->dst_regs_.size() != 1 || insn->obj_reg_ != nullptr) {
+    return false;
+  }
+  vm::Register *dst = insn->dst_regs_[0];
+  if (IsPinned(dst) || num_defs_[dst] != 1 || !IsNarrowNum(dst)) {
+    return false;
+  }
+  vector<uint64_t> v;
+  for (vm::Register *src : insn->src_regs_) {
+    uint64_t n;
+    if (!GetConstValue(src, &n)) {
+      return false;
+    }
+    v.push_back(n);
+  }
+  const vector<vm::Register *> &srcs = insn->src_regs_;
+  switch (insn->op_) {
+    case vm::OP_ADD:
+      *value = v[0] + v[1];
+      return true;
+    case vm::OP_SUB:
+      *value = v[0] - v[1];
+      return true;
+    case vm::OP_AND:
+    case vm::OP_OR:
+    case vm::OP_XOR:
+      if (Width(dst) != Width(srcs[0]) || Width(dst) != Width(srcs[1])) {
+        return false;
+      }
+      if (insn->op_ == vm::OP_AND) {
+        *value = v[0] & v[1];
+      } else if (insn->op_ == vm::OP_OR) {
+        *value = v[0] | v[1];
+      } else {
+        *value = v[0] ^ v[1];
+      }
+      return true;
+    case vm::OP_LSHIFT:
+    case vm::OP_RSHIFT:
+      if (Width(dst) != Width(srcs[0])) {
+        return false;
+      }
+      if (v[1] >= 64) {
+        *value = 0;
+      } else if (insn->op_ == vm::OP_LSHIFT) {
+        *value = v[0] << v[1];
+      } else {
+        *value = v[0] >> v[1];
+      }
+      return true;
+    case vm::OP_BIT_INV:
+    case vm::OP_PLUS:
+    case vm::OP_MINUS:
+      if (Width(dst) != Width(srcs[0])) {
+        return false;
+      }
+      if (insn->op_ == vm::OP_BIT_INV) {
+        *value = ~v[0];
+      } else if (insn->op_ == vm::OP_PLUS) {
+        *value = v[0];
+      } else {
+        *value = -v[0];
+      }
+      return true;
+    case vm::OP_CONCAT:
+      if (Width(dst) != Width(srcs[0]) + Width(srcs[1]) || Width(dst) > 64 ||
+          Width(srcs[1]) >= 64) {
+        return false;
+      }
+      *value = (v[0] << Width(srcs[1])) | v[1];
+      return true;
+    case vm::OP_BIT_RANGE:
+      if (v[1] >= 64 || v[1] < v[2] ||
+          (uint64_t)Width(dst) != v[1] - v[2] + 1) {
+        return false;
+      }
+      *value = v[0] >> v[2];
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+bool InsnOptimizer::GetConstValue(vm::Register *reg, uint64_t *value) {
+  if (const_regs_.find(reg) == const_regs_.end()) {
+    return false;
+  }
+  *value = reg->initial_num_.GetValue0() & WidthMask(Width(reg));
+  return true;
+}
+
+// Rewrites the first LOAD_OBJ of self to the NOP at the beginning and
+// shares it. Loads of a same member in a basic block are also shared
+// unless a call or a member write may change it.
+void InsnOptimizer::EliminateRedundantLoads() {
+  CollectLeaders();
+  auto &insns = method_->insns_;
+  vector<vm::Insn *> self_loads;
+  for (vm::Insn *insn : insns) {
+    if (insn->op_ == vm::OP_LOAD_OBJ && insn->label_ == nullptr) {
+      self_loads.push_back(insn);
+    }
+  }
+  if (self_loads.size() > 1 && insns[0]->op_ == vm::OP_NOP) {
+    vm::Register *self = self_loads[0]->dst_regs_[0];
+    vm::Insn *head = insns[0];
+    head->op_ = vm::OP_LOAD_OBJ;
+    head->label_ = nullptr;
+    head->dst_regs_.push_back(self);
+    head->insn_expr_ = self_loads[0]->insn_expr_;
+    head->insn_stmt_ = self_loads[0]->insn_stmt_;
+    map<vm::Register *, vm::Register *> replace;
+    for (vm::Insn *insn : self_loads) {
+      if (insn->dst_regs_[0] != self) {
+        replace[insn->dst_regs_[0]] = self;
+      }
+      Remove(insn);
+    }
+    ReplaceUses(replace);
+  }
+  // Replacements are applied at once at the end, so the object of a load
+  // is looked up in them.
+  map<vm::Register *, vm::Register *> replace;
+  map<std::pair<vm::Register *, sym_t>, vm::Register *> loaded;
+  for (size_t i = 0; i < insns.size(); ++i) {
+    vm::Insn *insn = insns[i];
+    if (leaders_[i] || insn->op_ == vm::OP_FUNCALL ||
+        insn->op_ == vm::OP_MEMBER_WRITE) {
+      loaded.clear();
+    }
+    if (insn->op_ != vm::OP_LOAD_OBJ || insn->label_ == nullptr) {
+      continue;
+    }
+    vm::Register *obj = insn->obj_reg_;
+    auto r = replace.find(obj);
+    if (r != replace.end()) {
+      obj = r->second;
+    }
+    auto key = std::make_pair(obj, insn->label_);
+    auto it = loaded.find(key);
+    if (it == loaded.end()) {
+      loaded[key] = insn->dst_regs_[0];
+    } else {
+      replace[insn->dst_regs_[0]] = it->second;
+      Remove(insn);
+    }
+  }
+  ReplaceUses(replace);
+}
+
+// Replaces uses of the destination of OP_ASSIGN with its source in the
+// basic block until either of them is updated.
+void InsnOptimizer::PropagateCopies() {
+  CoalesceTemporaries();
+  CollectLeaders();
+  map<vm::Register *, vm::Register *> copies;
+  auto &insns = method_->insns_;
+  for (size_t i = 0; i < insns.size(); ++i) {
+    vm::Insn *insn = insns[i];
+    if (leaders_[i]) {
+      copies.clear();
+    }
+    vector<int> indexes;
+    GetUseIndexes(insn, &indexes);
+    for (int idx : indexes) {
+      vm::Register *from = insn->src_regs_[idx];
+      auto it = copies.find(from);
+      if (it == copies.end()) {
+        continue;
+      }
+      insn->src_regs_[idx] = it->second;
+      if (insn->op_ == vm::OP_MEMBER_WRITE || insn->op_ == vm::OP_ARRAY_WRITE) {
+        // dst_regs_ of these just alias a source.
+        for (size_t j = 0; j < insn->dst_regs_.size(); ++j) {
+          if (insn->dst_regs_[j] == from) {
+            insn->dst_regs_[j] = it->second;
+          }
+        }
+      }
+    }
+    vector<vm::Register *> defs;
+    GetDefs(insn, &defs);
+    for (vm::Register *def : defs) {
+      copies.erase(def);
+      for (auto it = copies.begin(); it != copies.end();) {
+        if (it->second == def) {
+          it = copies.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    if (insn->op_ != vm::OP_ASSIGN) {
+      continue;
+    }
+    vm::Register *dst = insn->dst_regs_[0];
+    vm::Register *src = insn->src_regs_[1];
+    if (dst != src && IsSameType(dst, src) && !dst->type_.is_const_ &&
+        dst->GetAnnotation() == nullptr && src->GetAnnotation() == nullptr) {
+      copies[dst] = src;
+    }
+  }
+}
+
+// Lets an op write to the variable directly instead of a temporary
+// register copied by the next OP_ASSIGN.
+void InsnOptimizer::CoalesceTemporaries() {
+  CollectLeaders();
+  CountRegisters();
+  auto &insns = method_->insns_;
+  for (size_t i = 1; i < insns.size(); ++i) {
+    vm::Insn *assign = insns[i];
+    vm::Insn *def = insns[i - 1];
+    if (assign->op_ != vm::OP_ASSIGN || leaders_[i] || !IsCoalescable(def) ||
+        def->dst_regs_.size() != 1) {
+      continue;
+    }
+    vm::Register *tmp = assign->src_regs_[1];
+    vm::Register *var = assign->dst_regs_[0];
+    if (def->dst_regs_[0] != tmp || tmp == var || IsPinned(tmp) ||
+        tmp->orig_name_ != sym_null || num_defs_[tmp] != 1 ||
+        num_uses_[tmp] != 1 || !IsSameType(tmp, var) ||
+        var->type_.is_const_ || var->GetAnnotation() != nullptr) {
+      continue;
+    }
+    bool reads_var = (def->obj_reg_ == var);
+    for (vm::Register *src : def->src_regs_) {
+      if (src == var) {
+        reads_var = true;
+      }
+    }
+    if (reads_var && !(IsInPlace(def) && IsNarrowNum(var))) {
+      continue;
+    }
+    def->dst_regs_[0] = var;
+    Remove(assign);
+    num_uses_[tmp] = 0;
+    num_defs_[tmp] = 0;
+  }
+}
+
+void InsnOptimizer::EliminateDeadRegisters() {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    CountRegisters();
+    for (vm::Insn *insn : method_->insns_) {
+      if (!IsPure(insn) || insn->dst_regs_.size() == 0) {
+        continue;
+      }
+      bool is_dead = true;
+      for (vm::Register *dst : insn->dst_regs_) {
+        if (IsPinned(dst) || num_uses_[dst] > 0) {
+          is_dead = false;
+        }
+      }
+      if (is_dead) {
+        Remove(insn);
+        changed = true;
+      }
+    }
+  }
+}
+
+// Jumps to OP_NOPs or OP_GOTOs go to the final destination directly and
+// OP_GOTOs to the next insn are removed. OP_YIELDs are kept since they
+// let other threads run in a loop.
+void InsnOptimizer::ThreadJumps() {
+  auto &insns = method_->insns_;
+  for (vm::Insn *insn : insns) {
+    if (IsJump(insn)) {
+      insn->jump_target_ = FollowJump(insn->jump_target_);
+    }
+  }
+  for (size_t i = 0; i < insns.size(); ++i) {
+    vm::Insn *insn = insns[i];
+    if (insn->op_ == vm::OP_GOTO &&
+        FollowJump(i + 1) == insn->jump_target_) {
+      Remove(insn);
+    }
+  }
+}
+
+int InsnOptimizer::FollowJump(int target) {
+  auto &insns = method_->insns_;
+  int last = insns.size() - 1;
+  set<int> visited;
+  while (target < last) {
+    vm::Insn *insn = insns[target];
+    if (insn->op_ == vm::OP_NOP) {
+      ++target;
+    } else if (insn->op_ == vm::OP_GOTO &&
+               visited.find(target) == visited.end()) {
+      visited.insert(target);
+      target = insn->jump_target_;
+    } else {
+      break;
+    }
+  }
+  return target;
+}
+
+// Removes OP_NOPs except the last one (a jump target of the method end).
+void InsnOptimizer::RemoveNops() {
+  auto &insns = method_->insns_;
+  vector<vm::Insn *> kept;
+  // Index in kept for each old index.
+  vector<int> new_index(insns.size() + 1);
+  for (size_t i = 0; i < insns.size(); ++i) {
+    new_index[i] = kept.size();
+    if (insns[i]->op_ != vm::OP_NOP || i == insns.size() - 1) {
+      kept.push_back(insns[i]);
+    }
+  }
+  new_index[insns.size()] = kept.size();
+  for (vm::Insn *insn : kept) {
+    if (IsJump(insn) && insn->jump_target_ >= 0 &&
+        insn->jump_target_ <= insns.size()) {
+      insn->jump_target_ = new_index[insn->jump_target_];
+    }
+  }
+  insns = kept;
+}
+
+bool InsnOptimizer::IsNarrowNum(vm::Register *reg) {
+  return (reg->type_.value_type_ == vm::Value::NUM &&
+          reg->type_.object_name_ == sym_null &&
+          reg->type_object_ == nullptr &&
+          !reg->type_.num_width_.IsSigned() && Width(reg) <= 64);
+}
+
+bool InsnOptimizer::IsSameType(vm::Register *r0, vm::Register *r1) {
+  const vm::RegisterType &t0 = r0->type_;
+  const vm::RegisterType &t1 = r1->type_;
+  if (t0.value_type_ != vm::Value::NUM &&
+      t0.value_type_ != vm::Value::ENUM_ITEM) {
+    return false;
+  }
+  return (t0.value_type_ == t1.value_type_ &&
+          t0.enum_type_ == t1.enum_type_ &&
+          t0.num_width_.GetWidth() == t1.num_width_.GetWidth() &&
+          t0.num_width_.IsSigned() == t1.num_width_.IsSigned() &&
+          t0.object_name_ == sym_null && t1.object_name_ == sym_null &&
+          r0->type_object_ == nullptr && r1->type_object_ == nullptr);
+}
+
+bool InsnOptimizer::IsPinned(vm::Register *reg) {
+  return pinned_.find(reg) != pinned_.end();
+}
+
+void InsnOptimizer::CountRegisters() {
+  num_defs_.clear();
+  num_uses_.clear();
+  for (vm::Insn *insn : method_->insns_) {
+    vector<vm::Register *> regs;
+    GetDefs(insn, &regs);
+    for (vm::Register *reg : regs) {
+      ++num_defs_[reg];
+    }
+    regs.clear();
+    GetUses(insn, &regs);
+    for (vm::Register *reg : regs) {
+      ++num_uses_[reg];
+    }
+  }
+}
+
+void InsnOptimizer::CollectLeaders() {
+  auto &insns = method_->insns_;
+  leaders_.clear();
+  leaders_.resize(insns.size(), false);
+  if (insns.size() > 0) {
+    leaders_[0] = true;
+  }
+  for (size_t i = 0; i < insns.size(); ++i) {
+    vm::Insn *insn = insns[i];
+    if (!IsJump(insn)) {
+      continue;
+    }
+    if (insn->jump_target_ >= 0 && insn->jump_target_ < insns.size()) {
+      leaders_[insn->jump_target_] = true;
+    }
+    if (i + 1 < insns.size()) {
+      leaders_[i + 1] = true;
+    }
+  }
+}
+
+void InsnOptimizer::ReplaceUses(
+    const map<vm::Register *, vm::Register *> &replace) {
+  if (replace.empty()) {
+    return;
+  }
+  for (vm::Insn *insn : method_->insns_) {
+    auto it = replace.find(insn->obj_reg_);
+    if (it != replace.end()) {
+      insn->obj_reg_ = it->second;
+    }
+    vector<int> indexes;
+    GetUseIndexes(insn, &indexes);
+    for (int idx : indexes) {
+      it = replace.find(insn->src_regs_[idx]);
+      if (it != replace.end()) {
+        insn->src_regs_[idx] = it->second;
+      }
+    }
+    if (insn->op_ == vm::OP_MEMBER_WRITE || insn->op_ == vm::OP_ARRAY_WRITE) {
+      for (size_t i = 0; i < insn->dst_regs_.size(); ++i) {
+        it = replace.find(insn->dst_regs_[i]);
+        if (it != replace.end()) {
+          insn->dst_regs_[i] = it->second;
+        }
+      }
+    }
+  }
+}
+
+void InsnOptimizer::Remove(vm::Insn *insn) {
+  insn->op_ = vm::OP_NOP;
+  insn->dst_regs_.clear();
+  insn->src_regs_.clear();
+  insn->obj_reg_ = nullptr;
+  insn->label_ = nullptr;
+}
+
+void InsnOptimizer::GetUses(vm::Insn *insn, vector<vm::Register *> *uses) {
+  if (insn->obj_reg_ != nullptr) {
+    uses->push_back(insn->obj_reg_);
+  }
+  vector<int> indexes;
+  GetUseIndexes(insn, &indexes);
+  for (int idx : indexes) {
+    uses->push_back(insn->src_regs_[idx]);
+  }
+}
+
+void InsnOptimizer::GetDefs(vm::Insn *insn, vector<vm::Register *> *defs) {
+  if (insn->op_ == vm::OP_MEMBER_WRITE || insn->op_ == vm::OP_ARRAY_WRITE) {
+    return;
+  }
+  for (vm::Register *reg : insn->dst_regs_) {
+    defs->push_back(reg);
+  }
+}
+
+void InsnOptimizer::GetUseIndexes(vm::Insn *insn, vector<int> *indexes) {
+  switch (insn->op_) {
+    case vm::OP_ASSIGN:
+      // src_regs_[0] is the destination.
+      indexes->push_back(1);
+      return;
+    case vm::OP_NUM:
+    case vm::OP_PRE_INC:
+    case vm::OP_PRE_DEC:
+      // Only the destination itself.
+      return;
+    default:
+      break;
+  }
+  for (size_t i = 0; i < insn->src_regs_.size(); ++i) {
+    indexes->push_back(i);
+  }
+}
+
+}  // namespace compiler
@@ -0,0 +1,71 @@
+// -*- C++ -*-
+#ifndef _compiler_insn_optimizer_h_
+#define _compiler_insn_optimizer_h_
+
+#include <map>
+#include <set>
+
+#include "compiler/common.h"
+
+using std::map;
+using std::set;
+
+namespace compiler {
+
+// Runs passes over the byte code of a non top level method after its
+// labels are resolved and registers are typed.
+//
+// Each pass can be turned off with its flag char in --disable_opt
+// (e.g. --disable_opt=FJ).
+// F: constant folding, L: redundant load elimination, P: copy propagation,
+// D: dead register elimination, J: jump threading and O: all of them.
+class InsnOptimizer {
+ public:
+  InsnOptimizer(vm::Method *method, const string &disabled_passes);
+
+  void Optimize();
+  static bool IsPassEnabled(const string &disabled_passes, char pass);
+
+  // public: for LoopUnroller
+  static void GetUses(vm::Insn *insn, vector<vm::Register *> *uses);
+  static void GetDefs(vm::Insn *insn, vector<vm::Register *> *defs);
+
+ private:
+  bool IsOptimizable();
+  void FoldConstants();
+  void EliminateRedundantLoads();
+  void PropagateCopies();
+  void CoalesceTemporaries();
+  void EliminateDeadRegisters();
+  void ThreadJumps();
+  void RemoveNops();
+
+  bool FoldInsn(vm::Insn *insn, uint64_t *value);
+  bool GetConstValue(vm::Register *reg, uint64_t *value);
+  bool IsNarrowNum(vm::Register *reg);
+  bool IsSameType(vm::Register *r0, vm::Register *r1);
+  bool IsPinned(vm::Register *reg);
+  void CountRegisters();
+  void CollectLeaders();
+  // Replaces uses of the keys with the values.
+  void ReplaceUses(const map<vm::Register *, vm::Register *> &replace);
+  int FollowJump(int target);
+  void Remove(vm::Insn *insn);
+
+  // Indexes of src_regs_ which are read and can be replaced.
+  static void GetUseIndexes(vm::Insn *insn, vector<int> *indexes);
+
+  vm::Method *method_;
+  string disabled_passes_;
+  // Arguments, return values and annotated registers.
+  set<vm::Register *> pinned_;
+  set<vm::Register *> const_regs_;
+  map<vm::Register *, int> num_defs_;
+  map<vm::Register *, int> num_uses_;
+  // true if the insn starts a basic block.
+  vector<bool> leaders_;
+};
+
+}  // namespace compiler
+
+#endif  // _compiler_insn_optimizer_h_
@@ -0,0 +1,155 @@
+#include "compiler/insn_optimizer.h"
+
+#include "base/sym.h"
+#include "fe/fe.h"
+#include "fe/common.h"
+#include "iroha/base/file.h"
+#include "iroha/test_util.h"
+#include "karuta/env.h"
+#include "vm/insn.h"
+#include "vm/method.h"
+#include "vm/object.h"
+#include "vm/opcode.h"
+#include "vm/value.h"
+#include "vm/vm.h"
+
+namespace compiler {
+
+// Each method has a chance of its pass. Toplevel calls them to compile.
+static const char kSource[] =
+    "shared M object = Kernel.clone()\n"
+    "shared M.X object = Kernel.clone()\n"
+    "shared M.X.v #32 = 5\n"
+    "shared M.t #32[4]\n"
+    "\n"
+    "func M.fold() (#8) {\n"
+    "  return (3 + 4) & 15\n"
+    "}\n"
+    "\n"
+    "func M.load() (#32) {\n"
+    "  return X.v + X.v\n"
+    "}\n"
+    "\n"
+    "func M.copy(a #32, b #32) (#32) {\n"
+    "  var x #32 = a + b\n"
+    "  return x\n"
+    "}\n"
+    "\n"
+    "func M.dead(a #32) (#32) {\n"
+    "  var u #32 = a + 1\n"
+    "  var w #32 = t[a]\n"
+    "  return a\n"
+    "}\n"
+    "\n"
+    "func M.jump(n #32) (#32) {\n"
+    "  var s #32 = 0\n"
+    "  if n > 2 {\n"
+    "    if n > 4 {\n"
+    "      s = 1\n"
+    "    } else {\n"
+    "      s = 2\n"
+    "    }\n"
+    "  } else {\n"
+    "    s = 3\n"
+    "  }\n"
+    "  return s\n"
+    "}\n"
+    "\n"
+    "M.fold()\n"
+    "M.load()\n"
+    "M.copy(1, 2)\n"
+    "M.dead(3)\n"
+    "M.jump(5)\n";
+
+static const char kFileName[] = "insn-optimizer-test.karuta";
+
+// Runs the source and returns the compiled method.
+class OptimizedMethods {
+ public:
+  OptimizedMethods(const string &disabled_passes) {
+    Env::SetDisabledOptPasses(disabled_passes);
+    vm::Object *thr_obj = vm_.kernel_object_->Clone();
+    vm::Method *top = fe::FE::ImportFile(kFileName, &vm_, thr_obj);
+    ASSERT(top != nullptr && !top->IsCompileFailure());
+    vm_.AddThreadFromMethod(nullptr, thr_obj, top, 0);
+    vm_.Run();
+    Env::SetDisabledOptPasses("");
+    m_ = thr_obj->LookupValue(sym_lookup("M"), false)->object_;
+  }
+
+  vm::Method *Get(const char *name) {
+    vm::Method *method = m_->LookupValue(sym_lookup(name), false)->method_;
+    ASSERT(!method->IsCompileFailure());
+    return method;
+  }
+
+ private:
+  vm::VM vm_;
+  vm::Object *m_;
+};
+
+static int CountOps(vm::Method *method, int op) {
+  int n = 0;
+  for (vm::Insn *insn : method->insns_) {
+    if (insn->op_ == op) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+// Only the pass is enabled.
+static string OnlyPass(char pass) {
+  string passes = "FLPDJ";
+  passes.erase(passes.find(pass), 1);
+  return passes;
+}
+
+void TestInsnOptimizer() {
+  fe::FE fe(false, false, "");
+  fe::NodePool::Init();
+  iroha::File::RegisterFile(kFileName, kSource);
+
+  ASSERT(InsnOptimizer::IsPassEnabled("", 'F'));
+  ASSERT(!InsnOptimizer::IsPassEnabled("FJ", 'J'));
+  ASSERT(InsnOptimizer::IsPassEnabled("FJ", 'D'));
+  ASSERT(!InsnOptimizer::IsPassEnabled("O", 'D'));
+
+  OptimizedMethods before("O");
+
+  // F: 3 + 4 becomes OP_NUM.
+  OptimizedMethods fold(OnlyPass('F'));
+  ASSERT(CountOps(before.Get("fold"), vm::OP_ADD) == 1);
+  ASSERT(CountOps(fold.Get("fold"), vm::OP_ADD) == 0);
+
+  // L: X is loaded once.
+  OptimizedMethods load(OnlyPass('L'));
+  ASSERT(CountOps(load.Get("load"), vm::OP_LOAD_OBJ) <
+         CountOps(before.Get("load"), vm::OP_LOAD_OBJ));
+
+  // P: the sum is written to x without a temporary.
+  OptimizedMethods copy(OnlyPass('P'));
+  ASSERT(CountOps(copy.Get("copy"), vm::OP_ASSIGN) <
+         CountOps(before.Get("copy"), vm::OP_ASSIGN));
+
+  // D: u and w are never read. The array read is kept since it can be
+  // out of range.
+  OptimizedMethods dead(OnlyPass('D'));
+  ASSERT(CountOps(before.Get("dead"), vm::OP_ADD) == 1);
+  ASSERT(CountOps(dead.Get("dead"), vm::OP_ADD) == 0);
+  ASSERT(CountOps(dead.Get("dead"), vm::OP_ARRAY_READ) == 1);
+
+  // J: the goto of the return to the end is removed.
+  OptimizedMethods jump(OnlyPass('J'));
+  ASSERT(CountOps(jump.Get("jump"), vm::OP_GOTO) <
+         CountOps(before.Get("jump"), vm::OP_GOTO));
+  ASSERT(CountOps(jump.Get("jump"), vm::OP_NOP) == 1);
+
+  // All of them.
+  ASSERT(before.Get("jump")->insns_.size() >
+         OptimizedMethods("").Get("jump")->insns_.size());
+
+  fe::NodePool::Release();
+}
+
+}  // namespace compiler
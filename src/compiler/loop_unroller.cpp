@@ -0,0 +1,366 @@
+#include "compiler/loop_unroller.h"
+
+#include "compiler/insn_optimizer.h"
+#include "compiler/method_compiler.h"
+#include "karuta/annotation.h"
+#include "vm/array_wrapper.h"
+#include "vm/insn.h"
+#include "vm/int_array.h"
+#include "vm/method.h"
+#include "vm/opcode.h"
+#include "vm/register.h"
+#include "vm/value.h"
+
+namespace compiler {
+
+LoopUnroller::LoopUnroller(MethodCompiler *compiler, vm::Method *method)
+    : compiler_(compiler), method_(method) {}
+
+void LoopUnroller::Unroll() {
+  // From the end, so that the indexes of the remaining loops are kept.
+  for (int i = method_->insns_.size() - 1; i >= 0; --i) {
+    Loop loop;
+    if (FindLoop(i, &loop)) {
+      DoUnroll(loop);
+      i = loop.head;
+    }
+  }
+}
+
+bool LoopUnroller::FindLoop(int back, Loop *loop) {
+  vector<vm::Insn *> &insns = method_->insns_;
+  vm::Insn *goto_insn = insns[back];
+  if (goto_insn->op_ != vm::OP_GOTO || goto_insn->jump_target_ >= back) {
+    return false;
+  }
+  loop->head = goto_insn->jump_target_;
+  loop->back = back;
+  // The header has constants, the comparison and the exit.
+  vm::Insn *cmp = nullptr;
+  loop->exit = -1;
+  for (int i = loop->head; i < back; ++i) {
+    vm::Insn *insn = insns[i];
+    if (insn->op_ == vm::OP_IF) {
+      loop->exit = i;
+      break;
+    }
+    if ((insn->op_ == vm::OP_LT || insn->op_ == vm::OP_LTE) &&
+        cmp == nullptr) {
+      cmp = insn;
+      continue;
+    }
+    if (insn->op_ != vm::OP_NUM && insn->op_ != vm::OP_NOP &&
+        insn->op_ != vm::OP_YIELD) {
+      return false;
+    }
+  }
+  if (loop->exit < 0 || cmp == nullptr) {
+    return false;
+  }
+  vm::Insn *if_insn = insns[loop->exit];
+  if (if_insn->jump_target_ != back + 1 ||
+      if_insn->src_regs_[0] != cmp->dst_regs_[0]) {
+    return false;
+  }
+  vm::Register *var = cmp->src_regs_[0];
+  vm::Register *bound = cmp->src_regs_[1];
+  Annotation *an = var->GetAnnotation();
+  if (an == nullptr || an->GetNum() <= 1 || an->IsPipeline() ||
+      var->type_.value_type_ != vm::Value::NUM || !bound->type_.is_const_) {
+    return false;
+  }
+  loop->var = var;
+  loop->factor = an->GetNum();
+  // ++ at the end of the body.
+  loop->inc = -1;
+  for (int i = back - 1; i > loop->exit; --i) {
+    vm::Insn *insn = insns[i];
+    if (insn->op_ == vm::OP_NOP || insn->op_ == vm::OP_YIELD) {
+      continue;
+    }
+    if (insn->op_ == vm::OP_PRE_INC && insn->dst_regs_[0] == var) {
+      loop->inc = i;
+    }
+    break;
+  }
+  if (loop->inc < 0 || !FindInitialValue(loop) || !IsSimpleBody(*loop)) {
+    return false;
+  }
+  uint64_t end = bound->initial_num_.GetValue0();
+  if (cmp->op_ == vm::OP_LTE) {
+    ++end;
+  }
+  if (end <= loop->start) {
+    return false;
+  }
+  loop->trip_count = end - loop->start;
+  return (loop->trip_count % loop->factor) == 0;
+}
+
+bool LoopUnroller::FindInitialValue(Loop *loop) {
+  vector<vm::Insn *> &insns = method_->insns_;
+  for (int i = loop->head - 1; i >= 0; --i) {
+    vm::Insn *insn = insns[i];
+    if (insn->op_ == vm::OP_NUM || insn->op_ == vm::OP_NOP ||
+        insn->op_ == vm::OP_YIELD) {
+      continue;
+    }
+    if (insn->op_ != vm::OP_ASSIGN || insn->src_regs_[0] != loop->var ||
+        !insn->src_regs_[1]->type_.is_const_) {
+      return false;
+    }
+    loop->init = i;
+    loop->start = insn->src_regs_[1]->initial_num_.GetValue0();
+    return true;
+  }
+  return false;
+}
+
+bool LoopUnroller::IsSimpleBody(const Loop &loop) {
+  vector<vm::Insn *> &insns = method_->insns_;
+  for (int i = 0; i < insns.size(); ++i) {
+    vm::Insn *insn = insns[i];
+    bool in_body = (i > loop.exit && i <= loop.inc);
+    if (in_body && i < loop.inc) {
+      vector<vm::Register *> defs;
+      InsnOptimizer::GetDefs(insn, &defs);
+      for (vm::Register *reg : defs) {
+        if (reg == loop.var) {
+          return false;
+        }
+      }
+    }
+    if (!IsJump(insn) || i == loop.exit || i == loop.back) {
+      continue;
+    }
+    int target = insn->jump_target_;
+    if (in_body && target <= i) {
+      // Inner loop.
+      return false;
+    }
+    bool to_body = (target > loop.exit && target <= loop.inc);
+    if (in_body != to_body || (target > loop.init && target <= loop.exit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopUnroller::HasJumps(const Loop &loop) {
+  for (int i = loop.exit + 1; i <= loop.inc; ++i) {
+    if (IsJump(method_->insns_[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LoopUnroller::CollectTemporaries(const Loop &loop,
+                                      set<vm::Register *> *temps) {
+  if (HasJumps(loop)) {
+    return;
+  }
+  vector<vm::Insn *> &insns = method_->insns_;
+  // true if the first access in the body is a write.
+  map<vm::Register *, bool> written_first;
+  for (int i = loop.exit + 1; i < loop.inc; ++i) {
+    vector<vm::Register *> uses;
+    vector<vm::Register *> defs;
+    InsnOptimizer::GetUses(insns[i], &uses);
+    InsnOptimizer::GetDefs(insns[i], &defs);
+    for (vm::Register *reg : uses) {
+      written_first.insert(std::make_pair(reg, false));
+    }
+    for (vm::Register *reg : defs) {
+      written_first.insert(std::make_pair(reg, true));
+    }
+  }
+  set<vm::Register *> outside;
+  for (int i = 0; i < insns.size(); ++i) {
+    if (i > loop.exit && i <= loop.inc) {
+      continue;
+    }
+    vm::Insn *insn = insns[i];
+    outside.insert(insn->dst_regs_.begin(), insn->dst_regs_.end());
+    outside.insert(insn->src_regs_.begin(), insn->src_regs_.end());
+    outside.insert(insn->obj_reg_);
+  }
+  int num_pinned =
+      method_->GetNumArgRegisters() + method_->GetNumReturnRegisters();
+  for (int i = 0; i < num_pinned && i < method_->method_regs_.size(); ++i) {
+    outside.insert(method_->method_regs_[i]);
+  }
+  for (auto &p : written_first) {
+    vm::Register *reg = p.first;
+    if (p.second && outside.find(reg) == outside.end() &&
+        !reg->type_.is_const_ && reg->GetAnnotation() == nullptr) {
+      temps->insert(reg);
+    }
+  }
+}
+
+void LoopUnroller::DoUnroll(const Loop &loop) {
+  vector<vm::Insn *> &insns = method_->insns_;
+  set<vm::Register *> temps;
+  CollectTemporaries(loop, &temps);
+  int first = loop.exit + 1;
+  int len = loop.inc - loop.exit;
+  vector<vm::Insn *> body;
+  // Index of each insn of the original body in each copy.
+  vector<vector<int> > positions(loop.factor, vector<int>(len));
+  // Jumps in the body and the copy they belong to.
+  vector<std::pair<vm::Insn *, int> > jumps;
+  for (int k = 0; k < loop.factor; ++k) {
+    map<vm::Register *, vm::Register *> rename;
+    if (k > 0) {
+      for (vm::Register *reg : temps) {
+        rename[reg] = CopyRegister(reg);
+      }
+    }
+    // Registers holding the loop variable + a constant.
+    map<vm::Register *, uint64_t> offsets;
+    offsets[loop.var] = 0;
+    for (int i = 0; i < len; ++i) {
+      vm::Insn *orig = insns[first + i];
+      vm::Insn *insn = method_->NewInsn();
+      *insn = *orig;
+      if (k > 0) {
+        for (vm::Register *&reg : insn->dst_regs_) {
+          auto it = rename.find(reg);
+          if (it != rename.end()) {
+            reg = it->second;
+          }
+        }
+        for (vm::Register *&reg : insn->src_regs_) {
+          auto it = rename.find(reg);
+          if (it != rename.end()) {
+            reg = it->second;
+          }
+        }
+        auto it = rename.find(insn->obj_reg_);
+        if (it != rename.end()) {
+          insn->obj_reg_ = it->second;
+        }
+      }
+      MayAddBankIndex(loop, k, orig, offsets, insn, &body);
+      positions[k][i] = first + body.size();
+      body.push_back(insn);
+      if (IsJump(insn)) {
+        jumps.push_back(std::make_pair(insn, k));
+      }
+      vector<vm::Register *> defs;
+      InsnOptimizer::GetDefs(insn, &defs);
+      for (vm::Register *reg : defs) {
+        offsets.erase(reg);
+      }
+      if (insn->op_ == vm::OP_ADD) {
+        vm::Register *lhs = insn->src_regs_[0];
+        vm::Register *rhs = insn->src_regs_[1];
+        if (offsets.find(rhs) != offsets.end()) {
+          std::swap(lhs, rhs);
+        }
+        if (offsets.find(lhs) != offsets.end() && rhs->type_.is_const_) {
+          offsets[insn->dst_regs_[0]] =
+              offsets[lhs] + rhs->initial_num_.GetValue0();
+        }
+      }
+    }
+  }
+  for (auto &p : jumps) {
+    vm::Insn *insn = p.first;
+    insn->jump_target_ = positions[p.second][insn->jump_target_ - first];
+  }
+  int delta = body.size() - len;
+  for (int i = 0; i < insns.size(); ++i) {
+    vm::Insn *insn = insns[i];
+    if ((i < first || i > loop.inc) && IsJump(insn) &&
+        insn->jump_target_ > loop.inc) {
+      insn->jump_target_ += delta;
+    }
+  }
+  insns.erase(insns.begin() + first, insns.begin() + loop.inc + 1);
+  insns.insert(insns.begin() + first, body.begin(), body.end());
+  // The loop doesn't have to be unrolled again in synthesis. Other params
+  // (e.g. for the register) are kept.
+  Annotation *an = Annotation::Copy(loop.var->GetAnnotation());
+  an->RemoveParam("num");
+  loop.var->SetAnnotation(an);
+}
+
+vm::Register *LoopUnroller::CopyRegister(vm::Register *reg) {
+  vm::Register *copy = method_->NewRegister();
+  *copy = *reg;
+  copy->id_ = method_->method_regs_.size();
+  method_->method_regs_.push_back(copy);
+  return copy;
+}
+
+void LoopUnroller::MayAddBankIndex(const Loop &loop, int nth, vm::Insn *orig,
+                                   const map<vm::Register *, uint64_t> &offsets,
+                                   vm::Insn *insn, vector<vm::Insn *> *insns) {
+  bool is_write = (insn->op_ == vm::OP_ARRAY_WRITE);
+  if (!is_write && insn->op_ != vm::OP_ARRAY_READ) {
+    return;
+  }
+  vm::Object *array_obj = compiler_->GetVMObject(orig->obj_reg_);
+  if (array_obj == nullptr || !vm::ArrayWrapper::IsIntArray(array_obj)) {
+    return;
+  }
+  Annotation *an = vm::ArrayWrapper::GetAnnotation(array_obj);
+  if (an == nullptr || an->GetBanks() <= 1) {
+    return;
+  }
+  // Ports of these arrays are shared and not partitioned.
+  // MethodSynth rejects banks= for them.
+  if (an->IsAxiMaster() || an->IsAxiSlave() || an->IsExportSramIf() ||
+      an->GetNum() > 1) {
+    return;
+  }
+  vm::IntArray *array = vm::ArrayWrapper::GetIntArray(array_obj);
+  int s = is_write ? 1 : 0;
+  if (array->GetShape().size() != 1 || insn->src_regs_.size() != s + 1) {
+    return;
+  }
+  vm::Register *index_reg = insn->src_regs_[s];
+  auto it = offsets.find(index_reg);
+  if (it == offsets.end()) {
+    return;
+  }
+  uint64_t banks = an->GetBanks();
+  // The index in the first iteration.
+  uint64_t index = loop.start + nth + it->second;
+  uint64_t bank;
+  if (an->IsBlockPartition()) {
+    // The index is known only if the loop is completely unrolled.
+    uint64_t length = array->GetLength();
+    if (loop.trip_count != loop.factor || index >= length) {
+      return;
+    }
+    bank = index / ((length + banks - 1) / banks);
+  } else {
+    // The index increases by the factor in each iteration.
+    if (loop.factor % banks != 0) {
+      return;
+    }
+    bank = index % banks;
+  }
+  vm::Insn *num_insn = method_->NewInsn();
+  num_insn->op_ = vm::OP_NUM;
+  vm::Register *bank_reg = compiler_->AllocRegister();
+  bank_reg->type_.value_type_ = vm::Value::NUM;
+  bank_reg->type_.num_width_ = index_reg->type_.num_width_;
+  bank_reg->type_.is_const_ = true;
+  bank_reg->initial_num_.type_ = bank_reg->type_.num_width_;
+  bank_reg->initial_num_.SetValue0(bank);
+  bank_reg->SetIsDeclaredType(true);
+  num_insn->src_regs_.push_back(bank_reg);
+  num_insn->dst_regs_.push_back(bank_reg);
+  insns->push_back(num_insn);
+  insn->src_regs_.push_back(bank_reg);
+}
+
+bool LoopUnroller::IsJump(vm::Insn *insn) {
+  return insn->op_ == vm::OP_IF || insn->op_ == vm::OP_GOTO;
+}
+
+}  // namespace compiler
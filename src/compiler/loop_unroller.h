@@ -0,0 +1,67 @@
+// -*- C++ -*-
+#ifndef _compiler_loop_unroller_h_
+#define _compiler_loop_unroller_h_
+
+#include <map>
+#include <set>
+
+#include "compiler/common.h"
+
+using std::map;
+using std::set;
+
+namespace compiler {
+
+// Unrolls for loops with @(num=N) in a non top level method by copying the
+// byte code of the body N times.
+//
+// A loop is unrolled if its variable starts from a constant, is compared
+// with a constant bound by < or <= and is incremented by ++ at the end of
+// the body, and the trip count is a multiple of N. Temporary registers of
+// the body are renamed in each copy.
+//
+// Accesses of each copy to an array with @(banks=B) get the index of the
+// bank as an extra index, if the bank can be computed from the value of
+// the loop variable in the copy (i + c for a loop variable i and a
+// constant c). The extra index is ignored by the VM. Arrays with external
+// ports or copies are not partitioned and don't get the index.
+class LoopUnroller {
+ public:
+  LoopUnroller(MethodCompiler *compiler, vm::Method *method);
+
+  void Unroll();
+
+ private:
+  class Loop {
+   public:
+    // Insn indexes.
+    int init;
+    int head;
+    int exit;
+    int inc;
+    int back;
+    vm::Register *var;
+    int factor;
+    uint64_t start;
+    uint64_t trip_count;
+  };
+
+  bool FindLoop(int back, Loop *loop);
+  bool FindInitialValue(Loop *loop);
+  bool IsSimpleBody(const Loop &loop);
+  bool HasJumps(const Loop &loop);
+  void CollectTemporaries(const Loop &loop, set<vm::Register *> *temps);
+  void DoUnroll(const Loop &loop);
+  vm::Register *CopyRegister(vm::Register *reg);
+  void MayAddBankIndex(const Loop &loop, int nth, vm::Insn *orig,
+                       const map<vm::Register *, uint64_t> &offsets,
+                       vm::Insn *insn, vector<vm::Insn *> *insns);
+  static bool IsJump(vm::Insn *insn);
+
+  MethodCompiler *compiler_;
+  vm::Method *method_;
+};
+
+}  // namespace compiler
+
+#endif  // _compiler_loop_unroller_h_
@@ -0,0 +1,96 @@
+#include "compiler/loop_unroller.h"
+
+#include "base/sym.h"
+#include "fe/fe.h"
+#include "fe/common.h"
+#include "iroha/base/file.h"
+#include "iroha/test_util.h"
+#include "karuta/annotation.h"
+#include "vm/insn.h"
+#include "vm/method.h"
+#include "vm/object.h"
+#include "vm/opcode.h"
+#include "vm/register.h"
+#include "vm/value.h"
+#include "vm/vm.h"
+
+namespace compiler {
+
+// The first loop is unrolled and the second one is not, since 7 isn't a
+// multiple of 2.
+static const char kSource[] =
+    "shared M object = Kernel.clone()\n"
+    "@(banks=2)\n"
+    "shared M.a #32[8]\n"
+    "shared M.r #32\n"
+    "\n"
+    "func M.f() {\n"
+    "  @(num=2, name=\"u\")\n"
+    "  for var i #32 = 0; i < 8; ++i {\n"
+    "    a[i] = i + 1\n"
+    "  }\n"
+    "  var s #32 = 0\n"
+    "  @(num=2)\n"
+    "  for var j #32 = 0; j < 7; ++j {\n"
+    "    s += a[j]\n"
+    "  }\n"
+    "  r = s\n"
+    "}\n"
+    "\n"
+    "M.f()\n";
+
+static const char kFileName[] = "loop-unroller-test.karuta";
+
+static vm::Register *FindRegister(vm::Method *method, const char *name) {
+  for (vm::Register *reg : method->method_regs_) {
+    if (reg->orig_name_ == sym_lookup(name)) {
+      return reg;
+    }
+  }
+  return nullptr;
+}
+
+void TestLoopUnroller() {
+  fe::FE fe(false, false, "");
+  fe::NodePool::Init();
+  iroha::File::RegisterFile(kFileName, kSource);
+
+  vm::VM vm;
+  vm::Object *thr_obj = vm.kernel_object_->Clone();
+  vm::Method *top = fe::FE::ImportFile(kFileName, &vm, thr_obj);
+  ASSERT(top != nullptr && !top->IsCompileFailure());
+  vm.AddThreadFromMethod(nullptr, thr_obj, top, 0);
+  vm.Run();
+  vm::Object *m = thr_obj->LookupValue(sym_lookup("M"), false)->object_;
+  vm::Method *f = m->LookupValue(sym_lookup("f"), false)->method_;
+  ASSERT(!f->IsCompileFailure());
+
+  // 1 + 2 + ... + 7
+  vm::Value *r = m->LookupValue(sym_lookup("r"), false);
+  ASSERT(r->num_value_.GetValue0() == 28);
+
+  // Each copy of the write gets the bank as the extra index.
+  vector<uint64_t> banks;
+  int num_reads = 0;
+  for (vm::Insn *insn : f->insns_) {
+    if (insn->op_ == vm::OP_ARRAY_WRITE) {
+      ASSERT(insn->src_regs_.size() == 3);
+      banks.push_back(insn->src_regs_[2]->initial_num_.GetValue0());
+    }
+    if (insn->op_ == vm::OP_ARRAY_READ) {
+      ASSERT(insn->src_regs_.size() == 1);
+      ++num_reads;
+    }
+  }
+  ASSERT(banks.size() == 2 && banks[0] == 0 && banks[1] == 1);
+  ASSERT(num_reads == 1);
+
+  // Only num= is removed from the unrolled loop.
+  Annotation *an = FindRegister(f, "i")->GetAnnotation();
+  ASSERT(an != nullptr && an->GetNum() == 1 && an->GetName() == "u");
+  ASSERT(FindRegister(f, "j")->GetAnnotation()->GetNum() == 2);
+
+  fe::NodePool::Release();
+}
+
+}  // namespace compiler
@@ -3,13 +3,17 @@
 #include "base/status.h"
 #include "compiler/compiler.h"
 #include "compiler/expr_compiler.h"
+#include "compiler/insn_optimizer.h"
 #include "compiler/loop_marker.h"
+#include "compiler/loop_unroller.h"
 #include "compiler/reg_checker.h"
+#include "compiler/type_checker.h"
 #include "fe/expr.h"
 #include "fe/method.h"
 #include "fe/stmt.h"
 #include "fe/var_decl.h"
 #include "iroha/base/util.h"
+#include "karuta/env.h"
 #include "vm/decl_annotator.h"
 #include "vm/insn.h"
 #include "vm/insn_annotator.h"
@@ -92,6 +96,16 @@ void MethodCompiler::Compile() {
     method_->Dump();
   }
   vm::InsnAnnotator::AnnotateMethod(vm_, obj_, method_);
+  if (!method_->IsTopLevel() && !Status::CheckAllErrors(false)) {
+    TypeChecker type_checker(method_);
+    type_checker.Check();
+  }
+  if (!method_->IsTopLevel() && !method_->IsCompileFailure()) {
+    LoopUnroller unroller(this, method_);
+    unroller.Unroll();
+    InsnOptimizer optimizer(method_, Env::GetDisabledOptPasses());
+    optimizer.Optimize();
+  }
   if (vm::ByteCodeDebugMode::IsEnabled(dbg_bytecode_)) {
     // Top level result will be output after execution.
     if (!method_->IsTopLevel()) {
@@ -140,13 +154,13 @@ void MethodCompiler::ResolveLabels() {
 }
 
 void MethodCompiler::EmitNop() {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_NOP;
   EmitInsn(insn);
 }
 
 void MethodCompiler::EmitYield() {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_YIELD;
   EmitInsn(insn);
 }
@@ -236,7 +250,7 @@ void MethodCompiler::PushScope(fe::Stmt *stmt) {
 }
 
 void MethodCompiler::LoadScopeObj(fe::Expr *obj_expr) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_TL_PUSH_CURRENT_OBJECT;
   insn->insn_expr_ = obj_expr;
   vm::Register *obj_reg = nullptr;
@@ -259,7 +273,7 @@ void MethodCompiler::LoadScopeObj(fe::Expr *obj_expr) {
 void MethodCompiler::PopScope() {
   VarScope *scope = *(bindings_.rbegin());
   if (scope->obj_expr_ != nullptr) {
-    vm::Insn *insn = new vm::Insn;
+    vm::Insn *insn = NewInsn();
     insn->op_ = vm::OP_TL_POP_CURRENT_OBJECT;
     EmitInsn(insn);
   }
@@ -340,7 +354,7 @@ void MethodCompiler::CompileGoto(fe::Stmt *stmt) {
 }
 
 vm::Insn *MethodCompiler::EmitGoto() {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_GOTO;
   EmitYield();
   EmitInsn(insn);
@@ -358,7 +372,7 @@ void MethodCompiler::CompileReturn(fe::Stmt *stmt) {
     regs.push_back(rt.GetOne());
   }
   for (size_t i = 0; i < value_exprs.size(); ++i) {
-    vm::Insn *insn = new vm::Insn;
+    vm::Insn *insn = NewInsn();
     insn->op_ = vm::OP_ASSIGN;
     insn->insn_expr_ = value_exprs[i];
     insn->dst_regs_.push_back(GetNthReturnRegister(i));
@@ -368,7 +382,7 @@ void MethodCompiler::CompileReturn(fe::Stmt *stmt) {
   }
 
   // Goto the last insn.
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_GOTO;
   insn->insn_stmt_ = nullptr;
   EmitInsn(insn);
@@ -377,7 +391,7 @@ void MethodCompiler::CompileReturn(fe::Stmt *stmt) {
 void MethodCompiler::CompileLabel(fe::Stmt *stmt) { AddLabel(stmt->GetSym()); }
 
 void MethodCompiler::CompileIfStmt(fe::Stmt *stmt) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_IF;
   RegisterTuple rt = exc_->CompileExpr(stmt->GetExpr());
   insn->src_regs_.push_back(rt.GetOne());
@@ -429,7 +443,7 @@ void MethodCompiler::CompileVarDeclStmt(fe::Stmt *stmt) {
   if (obj_name != sym_null) {
     if (IsTopLevel()) {
       // Set type object later.
-      vm::Insn *insn = new vm::Insn;
+      vm::Insn *insn = NewInsn();
       insn->op_ = vm::OP_TL_SET_TYPE_OBJECT;
       insn->dst_regs_.push_back(reg);
       insn->insn_stmt_ = stmt;
@@ -473,7 +487,7 @@ void MethodCompiler::CompileMemberDeclStmt(fe::Stmt *stmt, fe::Expr *var_expr,
   CHECK(IsTopLevel());
   vm::Register *obj_reg = CompilePathHead(var_expr);
   // Object manipulation. do in the executor.
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = op;
   insn->insn_stmt_ = stmt;
   insn->obj_reg_ = obj_reg;
@@ -485,7 +499,7 @@ void MethodCompiler::CompileMemberDeclStmt(fe::Stmt *stmt, fe::Expr *var_expr,
   }
   EmitInsn(insn);
   if (op == vm::OP_TL_VARDECL && initial_val) {
-    insn = new vm::Insn;
+    insn = NewInsn();
     insn->op_ = vm::OP_MEMBER_WRITE;
     insn->label_ = var_expr->GetSym();
     insn->obj_reg_ = obj_reg;
@@ -496,7 +510,7 @@ void MethodCompiler::CompileMemberDeclStmt(fe::Stmt *stmt, fe::Expr *var_expr,
 }
 
 void MethodCompiler::CompileImportStmt(fe::Stmt *stmt) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_TL_IMPORT;
   insn->insn_stmt_ = stmt;
   sym_t name = stmt->GetSym();
@@ -509,7 +523,7 @@ void MethodCompiler::CompileImportStmt(fe::Stmt *stmt) {
 }
 
 void MethodCompiler::SimpleAssign(vm::Register *src, vm::Register *dst) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_ASSIGN;
   insn->src_regs_.push_back(dst);
   insn->src_regs_.push_back(src);
@@ -540,7 +554,7 @@ vm::Register *MethodCompiler::LookupOrAllocateLocalVar(sym_t name) {
 }
 
 void MethodCompiler::CompileFuncDecl(fe::Stmt *stmt) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->op_ = vm::OP_TL_FUNCDECL;
   fe::Expr *name_expr = stmt->GetExpr();
   if (name_expr != nullptr) {
@@ -573,8 +587,10 @@ vm::Register *MethodCompiler::TraverseMemberPath(fe::Expr *path_elem) {
   return EmitMemberLoad(obj_reg, path_elem->GetSym());
 }
 
+vm::Insn *MethodCompiler::NewInsn() { return method_->NewInsn(); }
+
 vm::Register *MethodCompiler::AllocRegister() {
-  vm::Register *reg = new vm::Register;
+  vm::Register *reg = method_->NewRegister();
   reg->id_ = method_->method_regs_.size();
   method_->method_regs_.push_back(reg);
   return reg;
@@ -594,7 +610,7 @@ int MethodCompiler::InsnIndexFromLabel(sym_t label) {
 }
 
 vm::Register *MethodCompiler::EmitLoadObj(sym_t label) {
-  vm::Insn *obj_insn = new vm::Insn;
+  vm::Insn *obj_insn = NewInsn();
   obj_insn->op_ = vm::OP_LOAD_OBJ;
   vm::Register *obj_reg = AllocRegister();
   obj_insn->dst_regs_.push_back(obj_reg);
@@ -613,7 +629,7 @@ vm::Register *MethodCompiler::EmitLoadObj(sym_t label) {
 }
 
 vm::Register *MethodCompiler::EmitMemberLoad(vm::Register *obj_reg, sym_t m) {
-  vm::Insn *insn = new vm::Insn;
+  vm::Insn *insn = NewInsn();
   insn->obj_reg_ = obj_reg;
   if (IsTopLevel()) {
     insn->op_ = vm::OP_TL_MEMBER_READ_WITH_CHECK;
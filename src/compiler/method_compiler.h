@@ -35,6 +35,8 @@ class MethodCompiler {
   vm::Object *GetObj() const;
   vm::Register *EmitLoadObj(sym_t label);
   void EmitInsn(vm::Insn *insn);
+  // Allocated in the vm::Method and freed with it.
+  vm::Insn *NewInsn();
   vm::Register *AllocRegister();
   vm::Register *LookupLocalVar(sym_t name);
   bool IsTopLevel() const;
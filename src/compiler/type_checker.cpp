@@ -0,0 +1,97 @@
+#include "compiler/type_checker.h"
+
+#include "base/status.h"
+#include "vm/insn.h"
+#include "vm/method.h"
+#include "vm/opcode.h"
+#include "vm/register.h"
+
+namespace compiler {
+
+TypeChecker::TypeChecker(vm::Method *method) : method_(method) {}
+
+void TypeChecker::Check() {
+  for (vm::Insn *insn : method_->insns_) {
+    CheckTyped(insn);
+  }
+  if (!untyped_.empty()) {
+    return;
+  }
+  for (vm::Insn *insn : method_->insns_) {
+    CheckOperands(insn);
+  }
+}
+
+void TypeChecker::CheckTyped(vm::Insn *insn) {
+  for (vm::Register *reg : insn->dst_regs_) {
+    ReportUntyped(insn, reg);
+  }
+  for (vm::Register *reg : insn->src_regs_) {
+    ReportUntyped(insn, reg);
+  }
+}
+
+void TypeChecker::CheckOperands(vm::Insn *insn) {
+  vm::OpCode op = insn->op_;
+  bool ok = true;
+  if (vm::InsnType::IsSameWidthNumBinOp(op) || vm::InsnType::IsShift(op) ||
+      op == vm::OP_CONCAT) {
+    ok = IsType(insn->src_regs_[0], vm::Value::NUM) &&
+         IsType(insn->src_regs_[1], vm::Value::NUM);
+  } else if (op == vm::OP_LT || op == vm::OP_GT || op == vm::OP_LTE ||
+             op == vm::OP_GTE) {
+    ok = IsType(insn->src_regs_[0], vm::Value::NUM) &&
+         IsType(insn->src_regs_[1], vm::Value::NUM);
+  } else if (op == vm::OP_EQ || op == vm::OP_NE) {
+    vm::RegisterType &lt = insn->src_regs_[0]->type_;
+    vm::RegisterType &rt = insn->src_regs_[1]->type_;
+    if (lt.value_type_ == vm::Value::NUM ||
+        lt.value_type_ == vm::Value::ENUM_ITEM ||
+        rt.value_type_ == vm::Value::NUM ||
+        rt.value_type_ == vm::Value::ENUM_ITEM) {
+      ok = (lt.value_type_ == rt.value_type_);
+    }
+  } else if (op == vm::OP_LAND || op == vm::OP_LOR) {
+    ok = IsType(insn->src_regs_[0], vm::Value::ENUM_ITEM) &&
+         IsType(insn->src_regs_[1], vm::Value::ENUM_ITEM);
+  } else if (op == vm::OP_BIT_RANGE || op == vm::OP_PLUS ||
+             op == vm::OP_MINUS) {
+    ok = IsType(insn->src_regs_[0], vm::Value::NUM);
+  } else if (op == vm::OP_IF) {
+    ok = IsType(insn->src_regs_[0], vm::Value::ENUM_ITEM);
+  }
+  if (!ok) {
+    ReportMismatch(insn);
+  }
+}
+
+bool TypeChecker::IsType(vm::Register *reg, vm::Value::ValueType type) {
+  return reg->type_.value_type_ == type;
+}
+
+void TypeChecker::ReportUntyped(vm::Insn *insn, vm::Register *reg) {
+  if (reg->type_.value_type_ != vm::Value::NONE ||
+      untyped_.find(reg) != untyped_.end()) {
+    return;
+  }
+  untyped_.insert(reg);
+  if (reg->orig_name_ != sym_null) {
+    Status::os(Status::USER_ERROR)
+        << "Failed to determine the type of: " << sym_cstr(reg->orig_name_);
+  } else {
+    Status::os(Status::USER_ERROR)
+        << "Failed to determine the type of a value in: "
+        << vm::OpCodeName(insn->op_);
+  }
+  MessageFlush::Get(Status::USER_ERROR);
+  method_->SetCompileFailure();
+}
+
+void TypeChecker::ReportMismatch(vm::Insn *insn) {
+  Status::os(Status::USER_ERROR)
+      << "Type mismatch of the operands of: " << vm::OpCodeName(insn->op_);
+  MessageFlush::Get(Status::USER_ERROR);
+  method_->SetCompileFailure();
+}
+
+}  // namespace compiler
@@ -0,0 +1,41 @@
+// -*- C++ -*-
+#ifndef _compiler_type_checker_h_
+#define _compiler_type_checker_h_
+
+#include <set>
+
+#include "compiler/common.h"
+#include "vm/value.h"
+
+using std::set;
+
+namespace compiler {
+
+// Checks the register types of a non top level method after they are
+// inferred from the declarations and member types by vm::InsnAnnotator.
+//
+// Registers of such methods are not annotated while they run, so every
+// register should have a type and operands of an insn should be consistent
+// here. Violations are reported as compile errors instead of failures in
+// the middle of the simulation.
+class TypeChecker {
+ public:
+  TypeChecker(vm::Method *method);
+
+  void Check();
+
+ private:
+  void CheckTyped(vm::Insn *insn);
+  void CheckOperands(vm::Insn *insn);
+  bool IsType(vm::Register *reg, vm::Value::ValueType type);
+  void ReportUntyped(vm::Insn *insn, vm::Register *reg);
+  void ReportMismatch(vm::Insn *insn);
+
+  vm::Method *method_;
+  // To report each register once.
+  set<vm::Register *> untyped_;
+};
+
+}  // namespace compiler
+
+#endif  // _compiler_type_checker_h_
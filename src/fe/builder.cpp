@@ -61,18 +61,16 @@ const iroha::NumericWidth WidthSpec::GetWidth(sym_t name,
 }
 
 Expr *Builder::NewExpr(NodeCode type) {
-  Expr *expr = new Expr(type);
+  Expr *expr = NodePool::NewExpr(type);
   ScannerPos &pos = expr->GetPos();
   ScannerInterface::GetPosition(&pos);
-  NodePool::AddExpr(expr);
   return expr;
 }
 
 Stmt *Builder::NewStmt(int type) {
-  Stmt *stmt = new Stmt(static_cast<NodeCode>(type));
+  Stmt *stmt = NodePool::NewStmt(static_cast<NodeCode>(type));
   ScannerPos &pos = stmt->GetPos();
   ScannerInterface::GetPosition(&pos);
-  NodePool::AddStmt(stmt);
   return stmt;
 }
 
@@ -116,8 +114,7 @@ Expr *Builder::FuncallExpr(Expr *func, Expr *args) {
 
 VarDecl *Builder::BuildVarDecl(Expr *var_expr, bool is_primitive,
 			       sym_t type, const iroha::NumericWidth *w) {
-  VarDecl *var = new VarDecl;
-  NodePool::AddVarDecl(var);
+  VarDecl *var = NodePool::NewVarDecl();
   var->SetNameExpr(var_expr);
   sym_t obj_name = sym_null;
   sym_t type_name = sym_null;
@@ -189,8 +186,7 @@ Expr *Builder::BitInvertExpr(Expr *arg) {
 
 VarDeclSet *Builder::ArgDeclList(VarDeclSet *decls, VarDecl *decl) {
   if (!decls) {
-    decls = new VarDeclSet;
-    NodePool::AddVarDeclSet(decls);
+    decls = NodePool::NewVarDeclSet();
   }
   if (decl) {
     decls->decls.push_back(decl);
@@ -200,8 +196,7 @@ VarDeclSet *Builder::ArgDeclList(VarDeclSet *decls, VarDecl *decl) {
 
 ExprSet *Builder::ExprList(ExprSet *exprs, Expr *expr) {
   if (exprs == nullptr) {
-    exprs = new ExprSet;
-    NodePool::AddExprSet(exprs);
+    exprs = NodePool::NewExprSet();
   }
   exprs->exprs.push_back(expr);
   return exprs;
@@ -209,8 +204,7 @@ ExprSet *Builder::ExprList(ExprSet *exprs, Expr *expr) {
 
 EnumDecl *Builder::EnumItemList(EnumDecl *decl, sym_t item) {
   if (decl == nullptr) {
-    decl = new EnumDecl;
-    NodePool::AddEnumDecl(decl);
+    decl = NodePool::NewEnumDecl();
   }
   decl->items.push_back(item);
   return decl;
@@ -226,8 +220,7 @@ VarDeclSet *Builder::ReturnDeclList(VarDeclSet *decls, VarDecl *decl) {
 
 VarDecl *Builder::ReturnType(bool is_primitive, sym_t type,
 			     const iroha::NumericWidth *w) {
-  VarDecl *v = new VarDecl;
-  NodePool::AddVarDecl(v);
+  VarDecl *v = NodePool::NewVarDecl();
   sym_t type_name = sym_null;
   sym_t obj_name = sym_null;
   if (is_primitive) {
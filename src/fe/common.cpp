@@ -1,5 +1,6 @@
 #include "fe/common.h"
 
+#include "base/arena.h"
 #include "fe/enum_decl.h"
 #include "fe/expr.h"
 #include "fe/method.h"
@@ -8,60 +9,43 @@
 
 namespace fe {
 
-Pool<EnumDecl> *NodePool::enums_;
-Pool<Expr> *NodePool::exprs_;
-Pool<ExprSet> *NodePool::expr_sets_;
-Pool<Method> *NodePool::methods_;
-Pool<Stmt> *NodePool::stmts_;
-Pool<VarDecl> *NodePool::decls_;
-Pool<VarDeclSet> *NodePool::decl_sets_;
+Arena *NodePool::arena_;
 
 void NodePool::Init() {
-  enums_ = new Pool<EnumDecl>();
-  exprs_ = new Pool<Expr>();
-  expr_sets_ = new Pool<ExprSet>();
-  methods_ = new Pool<Method>();
-  stmts_ = new Pool<Stmt>();
-  decls_ = new Pool<VarDecl>();
-  decl_sets_ = new Pool<VarDeclSet>();
+  arena_ = new Arena();
 }
 
 void NodePool::Release() {
-  delete enums_;
-  delete exprs_;
-  delete expr_sets_;
-  delete methods_;
-  delete stmts_;
-  delete decls_;
-  delete decl_sets_;
+  delete arena_;
+  arena_ = nullptr;
 }
 
-void NodePool::AddEnumDecl(EnumDecl *decl) {
-  enums_->Add(decl);
+EnumDecl *NodePool::NewEnumDecl() {
+  return arena_->New<EnumDecl>();
 }
 
-void NodePool::AddExpr(Expr *expr) {
-  exprs_->Add(expr);
+Expr *NodePool::NewExpr(NodeCode type) {
+  return arena_->New<Expr>(type);
 }
 
-void NodePool::AddExprSet(ExprSet *expr_set) {
-  expr_sets_->Add(expr_set);
+ExprSet *NodePool::NewExprSet() {
+  return arena_->New<ExprSet>();
 }
 
-void NodePool::AddMethod(Method *method) {
-  methods_->Add(method);
+Method *NodePool::NewMethod(const string &name) {
+  return arena_->New<Method>(name);
 }
 
-void NodePool::AddVarDecl(VarDecl *decl) {
-  decls_->Add(decl);
+VarDecl *NodePool::NewVarDecl() {
+  return arena_->New<VarDecl>();
 }
 
-void NodePool::AddVarDeclSet(VarDeclSet *decl_set) {
-  decl_sets_->Add(decl_set);
+VarDeclSet *NodePool::NewVarDeclSet() {
+  return arena_->New<VarDeclSet>();
 }
 
-void NodePool::AddStmt(Stmt *stmt) {
-  stmts_->Add(stmt);
+Stmt *NodePool::NewStmt(NodeCode type) {
+  return arena_->New<Stmt>(type);
 }
 
 }  // namespace fe
@@ -3,8 +3,11 @@
 #define _fe_common_
 
 #include "base/pool.h"
+#include "fe/nodecode.h"
 #include "karuta/karuta.h"
 
+class Arena;
+
 class Annotation;
 class AnnotationKeyValueSet;
 class DumpStream;
@@ -40,26 +43,23 @@ class Stmt;
 class VarDecl;
 class VarDeclSet;
 
+// Parse tree nodes are allocated from an arena in the parse order and
+// freed together by Release().
 class NodePool {
 public:
   static void Init();
   static void Release();
 
-  static void AddEnumDecl(EnumDecl *decl);
-  static void AddExpr(Expr *expr);
-  static void AddExprSet(ExprSet *expr_set);
-  static void AddStmt(Stmt *stmt);
-  static void AddMethod(Method *method);
-  static void AddVarDecl(VarDecl *decl);
-  static void AddVarDeclSet(VarDeclSet *decl_set);
+  static EnumDecl *NewEnumDecl();
+  static Expr *NewExpr(NodeCode type);
+  static ExprSet *NewExprSet();
+  static Stmt *NewStmt(NodeCode type);
+  static Method *NewMethod(const string &name);
+  static VarDecl *NewVarDecl();
+  static VarDeclSet *NewVarDeclSet();
 
-  static Pool<Expr> *exprs_;
-  static Pool<ExprSet> *expr_sets_;
-  static Pool<EnumDecl> *enums_;
-  static Pool<Method> *methods_;
-  static Pool<Stmt> *stmts_;
-  static Pool<VarDecl> *decls_;
-  static Pool<VarDeclSet> *decl_sets_;
+private:
+  static Arena *arena_;
 };
 
 }  // namespace fe
@@ -21,14 +21,13 @@ Expr *Emitter::block_var_;
 
 void Emitter::BeginFunction(Expr *name, bool is_process, bool is_always) {
   string formatted_name = FormatMethodName(name);
-  Method *method = new Method(formatted_name);
+  Method *method = NodePool::NewMethod(formatted_name);
   method->SetIsProcess(is_process, is_always);
   MethodDecl decl;
   decl.method_ = method;
   decl.name_expr_ = name;
   decl.name_ = formatted_name;
   method_stack_.push_back(decl);
-  NodePool::AddMethod(method);
 }
 
 void Emitter::BeginFunctionDecl(int kw, Expr *name) {
@@ -11,12 +11,15 @@
 #include "fe/emitter.h"
 #include "fe/method.h"
 #include "fe/nodecode.h"
+#include "fe/parse_tree_image.h"
 #include "fe/scanner.h"
 #include "fe/scanner_interface.h"
 #include "fe/scanner_pos.h"
 #include "iroha/base/file.h"
+#include "karuta/env.h"
 #include "vm/method.h"
 #include "vm/object.h"
+#include "vm/profile.h"
 #include "vm/thread.h"
 #include "vm/vm.h"
 
@@ -109,55 +112,6 @@ namespace fe {
 
 std::unique_ptr<fe::ScannerInfo> FE::scanner_info_;
 
-int ScannerInfo::LookupKeyword(sym_t sym) const {
-  static map<string, int> kw = {
-      {"always", K_ALWAYS},
-      {"as", K_AS},
-      {"bool", K_BOOL},
-      {"break", K_BREAK},
-      {"case", K_CASE},
-      {"channel", K_CHANNEL},
-      {"const", K_CONST},
-      {"continue", K_CONTINUE},
-      // For compatibility. Will be deleted.
-      {"def", K_FUNC},
-      {"default", K_DEFAULT},
-      {"do", K_DO},
-      {"else", K_ELSE},
-      {"enum", K_ENUM},
-      {"for", K_FOR},
-      {"func", K_FUNC},
-      {"function", K_FUNC},
-      {"goto", K_GOTO},
-      {"if", K_IF},
-      {"import", K_IMPORT},
-      {"input", K_INPUT},
-      {"int", K_INT},
-      {"mailbox", K_MAILBOX},
-      {"module", K_MODULE},
-      {"object", K_OBJECT},
-      {"output", K_OUTPUT},
-      {"process", K_PROCESS},
-      // ram and reg are experimental syntax sugar.
-      // We'll make these separate keywords, if users like them.
-      {"ram", K_SHARED},
-      {"reg", K_SHARED},
-      {"return", K_RETURN},
-      {"shared", K_SHARED},
-      {"string", K_STRING},
-      {"switch", K_SWITCH},
-      {"thread", K_THREAD},
-      {"var", K_VAR},
-      {"while", K_WHILE},
-      {"with", K_WITH},
-  };
-  auto it = kw.find(sym_str(sym));
-  if (it != kw.end()) {
-    return it->second;
-  }
-  return 0;
-}
-
 FE::FE(bool dbg_parser, bool dbg_scanner, string dbg_bytecode)
     : dbg_parser_(dbg_parser) {
   InitSyms();
@@ -185,6 +139,14 @@ void FE::Run(bool with_run, bool with_compile, bool vanilla,
       }
     }
   }
+  const string &profile_fn = Env::GetProfileOutput();
+  if (!profile_fn.empty()) {
+    if (!vm.GetProfile()->WriteCollapsedStacks(profile_fn)) {
+      Status::os(Status::USER_ERROR)
+          << "Failed to write the profile: " << profile_fn;
+      MessageFlush::Get(Status::USER_ERROR);
+    }
+  }
   vm.GC();
 
   NodePool::Release();
@@ -242,26 +204,46 @@ Method *FE::ReadFile(const string &file, bool import) {
   if (!im) {
     return nullptr;
   }
+  if (import) {
+    // Library files usually have the image.
+    Method *method = ParseTreeImage::Load(im);
+    if (method != nullptr) {
+      delete im;
+      return method;
+    }
+  }
   std::unique_ptr<Scanner> scanner(ScannerInterface::CreateScanner());
   scanner->SetFileImage(im);
 
   Emitter::BeginFunction(nullptr, false, false);
 
   int r = ::yyparse();
-  scanner->ReleaseFileImage();
 
   MethodDecl decl = Emitter::EndFunction();
   if (Status::Check(Status::USER_ERROR, true)) {
+    scanner->ReleaseFileImage();
     return nullptr;
   }
   if (r != 0) {
+    scanner->ReleaseFileImage();
     return nullptr;
   }
+  if (import) {
+    ParseTreeImage::Save(im, decl.method_);
+  }
+  scanner->ReleaseFileImage();
   return decl.method_;
 }
 
 FileImage *FE::GetFileImage(const string &fn, bool is_import) {
   std::unique_ptr<istream> is;
+  if (!is_import) {
+    // Most likely a regular file.
+    FileImage *im = Scanner::MapFileImage(fn);
+    if (im != nullptr) {
+      return im;
+    }
+  }
   if (is_import) {
     string sfn = fn;
     if (Util::HasSuffix(fn)) {
@@ -304,6 +286,45 @@ ScannerInfo *FE::BuildScannerInfo() {
   s_info->num_token = NUM;
   s_info->sym_token = SYM;
   s_info->str_token = STR;
+  s_info->AddKeyword("always", K_ALWAYS);
+  s_info->AddKeyword("as", K_AS);
+  s_info->AddKeyword("bool", K_BOOL);
+  s_info->AddKeyword("break", K_BREAK);
+  s_info->AddKeyword("case", K_CASE);
+  s_info->AddKeyword("channel", K_CHANNEL);
+  s_info->AddKeyword("const", K_CONST);
+  s_info->AddKeyword("continue", K_CONTINUE);
+  // For compatibility. Will be deleted.
+  s_info->AddKeyword("def", K_FUNC);
+  s_info->AddKeyword("default", K_DEFAULT);
+  s_info->AddKeyword("do", K_DO);
+  s_info->AddKeyword("else", K_ELSE);
+  s_info->AddKeyword("enum", K_ENUM);
+  s_info->AddKeyword("for", K_FOR);
+  s_info->AddKeyword("func", K_FUNC);
+  s_info->AddKeyword("function", K_FUNC);
+  s_info->AddKeyword("goto", K_GOTO);
+  s_info->AddKeyword("if", K_IF);
+  s_info->AddKeyword("import", K_IMPORT);
+  s_info->AddKeyword("input", K_INPUT);
+  s_info->AddKeyword("int", K_INT);
+  s_info->AddKeyword("mailbox", K_MAILBOX);
+  s_info->AddKeyword("module", K_MODULE);
+  s_info->AddKeyword("object", K_OBJECT);
+  s_info->AddKeyword("output", K_OUTPUT);
+  s_info->AddKeyword("process", K_PROCESS);
+  // ram and reg are experimental syntax sugar.
+  // We'll make these separate keywords, if users like them.
+  s_info->AddKeyword("ram", K_SHARED);
+  s_info->AddKeyword("reg", K_SHARED);
+  s_info->AddKeyword("return", K_RETURN);
+  s_info->AddKeyword("shared", K_SHARED);
+  s_info->AddKeyword("string", K_STRING);
+  s_info->AddKeyword("switch", K_SWITCH);
+  s_info->AddKeyword("thread", K_THREAD);
+  s_info->AddKeyword("var", K_VAR);
+  s_info->AddKeyword("while", K_WHILE);
+  s_info->AddKeyword("with", K_WITH);
   return s_info;
 }
 
@@ -0,0 +1,623 @@
+#include "fe/parse_tree_image.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+
+#include "base/util.h"
+#include "fe/enum_decl.h"
+#include "fe/expr.h"
+#include "fe/method.h"
+#include "fe/scanner.h"
+#include "fe/stmt.h"
+#include "fe/var_decl.h"
+#include "karuta/annotation.h"
+
+namespace fe {
+
+namespace {
+
+const char kImageMagic[] = "KARUTAC";
+// Bump this when the parse tree or this format changes.
+const uint32_t kImageFormat = 1;
+
+// Tags of pointers.
+enum PtrTag : uint8_t {
+  PTR_NULL,
+  PTR_REF,
+  PTR_NEW,
+};
+
+// Tags of syms.
+enum SymTag : uint8_t {
+  SYM_NULL,
+  SYM_NAMED,
+  // Labels allocated by sym_alloc_tmp_sym(). These are allocated again on
+  // load, so that they don't collide with labels of this process.
+  SYM_TMP,
+};
+
+class ImageWriter {
+ public:
+  void Write(Method *method) {
+    buf_.append(kImageMagic, sizeof(kImageMagic));
+    PutU32(kImageFormat);
+    PutStr(Env::GetVersion());
+    PutMethod(method);
+  }
+
+  bool HasError() const { return has_error_; }
+  const string &GetBuf() const { return buf_; }
+
+ private:
+  void PutU8(uint8_t v) { buf_.push_back(static_cast<char>(v)); }
+
+  void PutU32(uint32_t v) { buf_.append((const char *)&v, sizeof(v)); }
+
+  void PutU64(uint64_t v) { buf_.append((const char *)&v, sizeof(v)); }
+
+  void PutStr(const string &s) {
+    PutU32(s.size());
+    buf_.append(s);
+  }
+
+  void PutSym(sym_t sym) {
+    if (sym == sym_null) {
+      PutU8(SYM_NULL);
+      return;
+    }
+    auto it = tmp_syms_.find(sym);
+    if (it != tmp_syms_.end()) {
+      PutU8(SYM_TMP);
+      PutU32(it->second);
+      // "_t" + suffix + "_" + index.
+      string s = sym_str(sym);
+      PutStr(s.substr(2, s.rfind('_') - 2));
+      return;
+    }
+    PutU8(SYM_NAMED);
+    PutStr(sym_str(sym));
+  }
+
+  void AddTmpSym(sym_t sym) {
+    if (sym != sym_null && tmp_syms_.find(sym) == tmp_syms_.end()) {
+      int index = tmp_syms_.size();
+      tmp_syms_[sym] = index;
+    }
+  }
+
+  // Returns true if the object should be written.
+  bool PutPtr(const void *p) {
+    if (p == nullptr) {
+      PutU8(PTR_NULL);
+      return false;
+    }
+    auto it = ids_.find(p);
+    if (it != ids_.end()) {
+      PutU8(PTR_REF);
+      PutU32(it->second);
+      return false;
+    }
+    int id = ids_.size();
+    ids_[p] = id;
+    PutU8(PTR_NEW);
+    return true;
+  }
+
+  void PutPos(ScannerPos &pos) {
+    PutU32(pos.line);
+    PutU32(pos.pos);
+    PutStr(pos.file != nullptr ? pos.file->file : "");
+  }
+
+  void PutWidth(const iroha::NumericWidth &w) {
+    PutU8(w.IsSigned());
+    PutU32(w.GetWidth());
+  }
+
+  void PutMethod(Method *method) {
+    if (!PutPtr(method)) {
+      return;
+    }
+    PutStr(method->GetName());
+    const vector<Stmt *> &stmts = method->GetStmts();
+    // Labels of the if, for and while stmts. Emitted label and goto stmts
+    // refer them, so they are registered before the stmts are written.
+    for (Stmt *stmt : stmts) {
+      if (stmt->GetType() == STMT_IF) {
+        AddTmpSym(stmt->GetLabel(false, true));
+        AddTmpSym(stmt->GetLabel(false, false));
+        AddTmpSym(stmt->GetLabel(true, false));
+      }
+    }
+    PutU32(stmts.size());
+    for (Stmt *stmt : stmts) {
+      PutStmt(stmt);
+    }
+    PutVarDeclSet(method->GetArgs());
+    PutVarDeclSet(method->GetReturns());
+    PutAnnotation(method->GetAnnotation());
+    PutU8(method->GetIsProcess());
+    PutU8(method->GetIsLoop());
+  }
+
+  void PutStmt(Stmt *stmt) {
+    if (!PutPtr(stmt)) {
+      return;
+    }
+    PutU32(stmt->GetType());
+    PutPos(stmt->GetPos());
+    PutExpr(stmt->GetExpr());
+    PutSym(stmt->GetSym());
+    PutMethod(stmt->GetMethodDef());
+    PutStr(stmt->GetString());
+    PutVarDecl(stmt->GetVarDecl());
+    PutEnumDecl(stmt->GetEnumDecl());
+    PutAnnotation(stmt->GetAnnotation());
+    PutWidth(stmt->GetWidth());
+    PutSym(stmt->GetLabel(false, true));
+    PutSym(stmt->GetLabel(false, false));
+    PutSym(stmt->GetLabel(true, false));
+  }
+
+  void PutExpr(Expr *expr) {
+    if (!PutPtr(expr)) {
+      return;
+    }
+    PutU32(expr->GetType());
+    PutPos(expr->GetPos());
+    const iroha::Numeric &num = expr->GetNum();
+    if (num.type_.IsExtraWide()) {
+      // The value is in a separate storage.
+      has_error_ = true;
+    }
+    PutWidth(num.type_);
+    PutU64(num.GetValue().value_[0]);
+    PutU64(num.GetValue().value_[1]);
+    PutSym(expr->GetSym());
+    PutStr(expr->GetString());
+    PutExpr(expr->GetFunc());
+    PutExpr(expr->GetArgs());
+    PutExpr(expr->GetLhs());
+    PutExpr(expr->GetRhs());
+  }
+
+  void PutVarDecl(VarDecl *decl) {
+    if (!PutPtr(decl)) {
+      return;
+    }
+    PutExpr(decl->GetNameExpr());
+    PutSym(decl->GetType());
+    PutWidth(decl->GetWidth());
+    PutSym(decl->GetObjectName());
+    PutU8(decl->GetIsShared());
+    PutU8(decl->GetIsIO());
+    PutU8(decl->GetIsOutput());
+    PutExpr(decl->GetInitialVal());
+    ArrayInitializer *initializer = decl->GetArrayInitializer();
+    PutU8(initializer != nullptr);
+    if (initializer != nullptr) {
+      PutU32(initializer->num_.size());
+      for (uint64_t n : initializer->num_) {
+        PutU64(n);
+      }
+    }
+    ArrayShape *shape = decl->GetArrayShape();
+    PutU8(shape != nullptr);
+    if (shape != nullptr) {
+      PutU32(shape->length.size());
+      for (int l : shape->length) {
+        PutU32(l);
+      }
+    }
+    PutAnnotation(decl->GetAnnotation());
+  }
+
+  void PutVarDeclSet(VarDeclSet *decls) {
+    if (!PutPtr(decls)) {
+      return;
+    }
+    PutU32(decls->decls.size());
+    for (VarDecl *decl : decls->decls) {
+      PutVarDecl(decl);
+    }
+  }
+
+  void PutEnumDecl(EnumDecl *decl) {
+    if (!PutPtr(decl)) {
+      return;
+    }
+    PutU32(decl->items.size());
+    for (sym_t item : decl->items) {
+      PutSym(item);
+    }
+  }
+
+  void PutAnnotation(Annotation *an) {
+    if (!PutPtr(an)) {
+      return;
+    }
+    vector<AnnotationKeyValue *> params;
+    an->GetAllParams(&params);
+    PutU32(params.size());
+    for (AnnotationKeyValue *p : params) {
+      PutStr(p->key_);
+      PutU8(p->has_str_);
+      PutStr(p->str_value_);
+      PutU64(p->int_value_);
+    }
+    int num_pins = an->GetNrPinDecls();
+    PutU32(num_pins);
+    for (int i = 0; i < num_pins; ++i) {
+      ResourceParams_pin pin;
+      an->GetNthPinDecl(i, &pin);
+      PutSym(pin.name);
+      PutU8(pin.is_out);
+      PutU32(pin.width);
+    }
+  }
+
+  string buf_;
+  bool has_error_ = false;
+  std::map<const void *, int> ids_;
+  std::map<sym_t, int> tmp_syms_;
+};
+
+class ImageReader {
+ public:
+  ImageReader(const char *p, size_t size) : p_(p), end_(p + size) {}
+
+  Method *Read() {
+    if (size_t(end_ - p_) < sizeof(kImageMagic) ||
+        memcmp(p_, kImageMagic, sizeof(kImageMagic)) != 0) {
+      return nullptr;
+    }
+    p_ += sizeof(kImageMagic);
+    if (GetU32() != kImageFormat || GetStr() != Env::GetVersion()) {
+      return nullptr;
+    }
+    Method *method = GetMethod();
+    if (has_error_ || p_ != end_) {
+      return nullptr;
+    }
+    return method;
+  }
+
+ private:
+  bool Check(size_t s) {
+    if (has_error_ || size_t(end_ - p_) < s) {
+      has_error_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  uint8_t GetU8() {
+    if (!Check(1)) {
+      return 0;
+    }
+    return static_cast<uint8_t>(*p_++);
+  }
+
+  uint32_t GetU32() {
+    uint32_t v = 0;
+    if (Check(sizeof(v))) {
+      memcpy(&v, p_, sizeof(v));
+      p_ += sizeof(v);
+    }
+    return v;
+  }
+
+  uint64_t GetU64() {
+    uint64_t v = 0;
+    if (Check(sizeof(v))) {
+      memcpy(&v, p_, sizeof(v));
+      p_ += sizeof(v);
+    }
+    return v;
+  }
+
+  string GetStr() {
+    uint32_t s = GetU32();
+    if (!Check(s)) {
+      return string();
+    }
+    string str(p_, s);
+    p_ += s;
+    return str;
+  }
+
+  sym_t GetSym() {
+    uint8_t tag = GetU8();
+    if (tag == SYM_NAMED) {
+      return sym_lookup(GetStr().c_str());
+    }
+    if (tag == SYM_TMP) {
+      uint32_t index = GetU32();
+      string suffix = GetStr();
+      auto it = tmp_syms_.find(index);
+      if (it != tmp_syms_.end()) {
+        return it->second;
+      }
+      sym_t sym = sym_alloc_tmp_sym(suffix.c_str());
+      tmp_syms_[index] = sym;
+      return sym;
+    }
+    if (tag != SYM_NULL) {
+      has_error_ = true;
+    }
+    return sym_null;
+  }
+
+  // Returns true if a new object follows. *p is set for a reference.
+  template <class T>
+  bool GetPtr(T **p) {
+    *p = nullptr;
+    uint8_t tag = GetU8();
+    if (tag == PTR_NEW) {
+      return true;
+    }
+    if (tag == PTR_REF) {
+      uint32_t id = GetU32();
+      if (id >= objs_.size()) {
+        has_error_ = true;
+        return false;
+      }
+      *p = static_cast<T *>(objs_[id]);
+    } else if (tag != PTR_NULL) {
+      has_error_ = true;
+    }
+    return false;
+  }
+
+  void GetPos(ScannerPos *pos) {
+    pos->line = GetU32();
+    pos->pos = GetU32();
+    string fn = GetStr();
+    if (!fn.empty()) {
+      pos->file = Scanner::GetScannerFile(fn);
+    }
+  }
+
+  iroha::NumericWidth GetWidth() {
+    bool is_signed = GetU8();
+    int width = GetU32();
+    return iroha::NumericWidth(is_signed, width);
+  }
+
+  Method *GetMethod() {
+    Method *method;
+    if (!GetPtr(&method) || has_error_) {
+      return method;
+    }
+    string name = GetStr();
+    method = NodePool::NewMethod(name);
+    objs_.push_back(method);
+    uint32_t num_stmts = GetU32();
+    vector<Stmt *> &stmts = method->GetMutableStmts();
+    for (uint32_t i = 0; i < num_stmts && !has_error_; ++i) {
+      stmts.push_back(GetStmt());
+    }
+    method->SetArgs(GetVarDeclSet());
+    method->SetReturns(GetVarDeclSet());
+    method->SetAnnotation(GetAnnotation());
+    bool is_process = GetU8();
+    bool is_loop = GetU8();
+    method->SetIsProcess(is_process, is_loop);
+    return method;
+  }
+
+  Stmt *GetStmt() {
+    Stmt *stmt;
+    if (!GetPtr(&stmt) || has_error_) {
+      return stmt;
+    }
+    stmt = NodePool::NewStmt(static_cast<NodeCode>(GetU32()));
+    objs_.push_back(stmt);
+    GetPos(&stmt->GetPos());
+    stmt->SetExpr(GetExpr());
+    stmt->SetSym(GetSym());
+    stmt->SetMethodDef(GetMethod());
+    stmt->SetString(GetStr());
+    stmt->SetVarDecl(GetVarDecl());
+    stmt->SetEnumDecl(GetEnumDecl());
+    stmt->SetAnnotation(GetAnnotation());
+    iroha::NumericWidth width = GetWidth();
+    stmt->SetWidth(width);
+    stmt->SetLabel(false, true, GetSym());
+    stmt->SetLabel(false, false, GetSym());
+    stmt->SetLabel(true, false, GetSym());
+    return stmt;
+  }
+
+  Expr *GetExpr() {
+    Expr *expr;
+    if (!GetPtr(&expr) || has_error_) {
+      return expr;
+    }
+    expr = NodePool::NewExpr(static_cast<NodeCode>(GetU32()));
+    objs_.push_back(expr);
+    GetPos(&expr->GetPos());
+    iroha::Numeric num;
+    num.type_ = GetWidth();
+    num.GetMutableValue()->value_[0] = GetU64();
+    num.GetMutableValue()->value_[1] = GetU64();
+    expr->SetNum(num);
+    expr->SetSym(GetSym());
+    expr->SetString(GetStr());
+    expr->SetFunc(GetExpr());
+    expr->SetArgs(GetExpr());
+    expr->SetLhs(GetExpr());
+    expr->SetRhs(GetExpr());
+    return expr;
+  }
+
+  VarDecl *GetVarDecl() {
+    VarDecl *decl;
+    if (!GetPtr(&decl) || has_error_) {
+      return decl;
+    }
+    decl = NodePool::NewVarDecl();
+    objs_.push_back(decl);
+    decl->SetNameExpr(GetExpr());
+    decl->SetType(GetSym());
+    decl->SetWidth(GetWidth());
+    decl->SetObjectName(GetSym());
+    decl->SetIsShared(GetU8());
+    bool is_io = GetU8();
+    bool is_output = GetU8();
+    decl->SetIsIO(is_io, is_output);
+    decl->SetInitialVal(GetExpr());
+    if (GetU8()) {
+      ArrayInitializer *initializer = new ArrayInitializer;
+      uint32_t n = GetU32();
+      for (uint32_t i = 0; i < n && Check(sizeof(uint64_t)); ++i) {
+        initializer->num_.push_back(GetU64());
+      }
+      decl->SetArrayInitializer(initializer);
+    }
+    if (GetU8()) {
+      uint32_t n = GetU32();
+      ArrayShape *shape = new ArrayShape(0);
+      shape->length.clear();
+      for (uint32_t i = 0; i < n && Check(sizeof(uint32_t)); ++i) {
+        shape->length.push_back(GetU32());
+      }
+      decl->SetArrayShape(shape);
+    }
+    decl->SetAnnotation(GetAnnotation());
+    return decl;
+  }
+
+  VarDeclSet *GetVarDeclSet() {
+    VarDeclSet *decls;
+    if (!GetPtr(&decls) || has_error_) {
+      return decls;
+    }
+    decls = NodePool::NewVarDeclSet();
+    objs_.push_back(decls);
+    uint32_t n = GetU32();
+    for (uint32_t i = 0; i < n && !has_error_; ++i) {
+      decls->decls.push_back(GetVarDecl());
+    }
+    return decls;
+  }
+
+  EnumDecl *GetEnumDecl() {
+    EnumDecl *decl;
+    if (!GetPtr(&decl) || has_error_) {
+      return decl;
+    }
+    decl = NodePool::NewEnumDecl();
+    objs_.push_back(decl);
+    uint32_t n = GetU32();
+    for (uint32_t i = 0; i < n && !has_error_; ++i) {
+      decl->items.push_back(GetSym());
+    }
+    return decl;
+  }
+
+  Annotation *GetAnnotation() {
+    Annotation *an;
+    if (!GetPtr(&an) || has_error_) {
+      return an;
+    }
+    AnnotationKeyValueSet *params = new AnnotationKeyValueSet;
+    an = new Annotation(params);
+    objs_.push_back(an);
+    uint32_t n = GetU32();
+    for (uint32_t i = 0; i < n && !has_error_; ++i) {
+      AnnotationKeyValue *p = new AnnotationKeyValue;
+      p->key_ = GetStr();
+      p->has_str_ = GetU8();
+      p->str_value_ = GetStr();
+      p->int_value_ = GetU64();
+      params->params_.push_back(p);
+    }
+    n = GetU32();
+    for (uint32_t i = 0; i < n && !has_error_; ++i) {
+      sym_t name = GetSym();
+      bool is_out = GetU8();
+      int width = GetU32();
+      an->AddPinDecl(name, is_out, width);
+    }
+    return an;
+  }
+
+  const char *p_;
+  const char *end_;
+  bool has_error_ = false;
+  vector<void *> objs_;
+  std::map<uint32_t, sym_t> tmp_syms_;
+};
+
+}  // namespace
+
+Method *ParseTreeImage::Load(const FileImage *im) {
+  if (Env::GetKarutacDir().empty()) {
+    return nullptr;
+  }
+  string path = GetImagePath(GetKey(im));
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  Method *method = nullptr;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      ImageReader reader((const char *)p, st.st_size);
+      method = reader.Read();
+      munmap(p, st.st_size);
+    }
+  }
+  close(fd);
+  if (method == nullptr) {
+    // Nodes decoded so far are released with NodePool.
+    LOG(INFO) << "Invalid image: " << path;
+  }
+  return method;
+}
+
+void ParseTreeImage::Save(const FileImage *im, Method *method) {
+  if (Env::GetKarutacDir().empty()) {
+    return;
+  }
+  ImageWriter writer;
+  writer.Write(method);
+  if (writer.HasError()) {
+    return;
+  }
+  string path = GetImagePath(GetKey(im));
+  // Renames a complete file, so that a concurrent run doesn't read a
+  // partial image.
+  string tmp = path + "." + std::to_string(getpid()) + "~";
+  FILE *fp = fopen(tmp.c_str(), "wb");
+  if (fp == nullptr) {
+    return;
+  }
+  const string &buf = writer.GetBuf();
+  bool ok = (fwrite(buf.data(), 1, buf.size(), fp) == buf.size());
+  ok &= (fclose(fp) == 0);
+  if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+    remove(tmp.c_str());
+  }
+}
+
+string ParseTreeImage::GetKey(const FileImage *im) {
+  // The file name is a part of the key, since ScannerPos refers it.
+  string content(im->text, im->text_size);
+  return ::Util::HashString(im->file_name + '\0' + content);
+}
+
+string ParseTreeImage::GetImagePath(const string &key) {
+  return Env::GetKarutacDir() + "/" + key + ".karutac";
+}
+
+}  // namespace fe
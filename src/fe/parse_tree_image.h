@@ -0,0 +1,26 @@
+// -*- C++ -*-
+#ifndef _fe_parse_tree_image_h_
+#define _fe_parse_tree_image_h_
+
+#include "fe/common.h"
+
+namespace fe {
+
+// Serialized parse tree of a source file (.karutac) to skip scanning and
+// parsing of library files on each run. Images are stored under
+// --karutac_dir and named by the hash of the file name and the content,
+// so an edited file just misses.
+class ParseTreeImage {
+ public:
+  // Returns nullptr if the image doesn't exist or is invalid.
+  static Method *Load(const FileImage *im);
+  static void Save(const FileImage *im, Method *method);
+
+ private:
+  static string GetKey(const FileImage *im);
+  static string GetImagePath(const string &key);
+};
+
+}  // namespace fe
+
+#endif  // _fe_parse_tree_image_h_
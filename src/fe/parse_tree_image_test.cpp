@@ -0,0 +1,186 @@
+#include "fe/parse_tree_image.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+#include <sstream>
+
+#include "base/dump_stream.h"
+#include "base/sym.h"
+#include "compiler/compiler.h"
+#include "fe/fe.h"
+#include "fe/method.h"
+#include "iroha/base/file.h"
+#include "iroha/test_util.h"
+#include "karuta/env.h"
+#include "vm/method.h"
+#include "vm/object.h"
+#include "vm/value.h"
+#include "vm/vm.h"
+
+namespace fe {
+
+// Covers declarations, annotations, control flow and expressions.
+static const char kSource[] =
+    "// Parse tree image test.\n"
+    "shared M object = Kernel.clone()\n"
+    "shared M.n #32 = 0x1f_ff\n"
+    "shared M.arr int[4] = {1, 2, 3, 4}\n"
+    "channel M.ch int\n"
+    "\n"
+    "@Pipeline(ii=2)\n"
+    "func M.f(a #32, b #16) (#32, int) {\n"
+    "  var acc #32 = 0\n"
+    "  for var i int = 0; i < 4; ++i {\n"
+    "    if (a > i && b != 3) {\n"
+    "      acc += (a * b) + arr[i]\n"
+    "    } else {\n"
+    "      acc = acc[7:0] :: b[7:0]\n"
+    "    }\n"
+    "  }\n"
+    "  while acc > 100 {\n"
+    "    acc = acc >> 1\n"
+    "  }\n"
+    "  return acc, 2\n"
+    "}\n"
+    "\n"
+    "@process_entry(num=2)\n"
+    "func M.t(idx int) {\n"
+    "  ch.write(idx)\n"
+    "}\n"
+    "\n"
+    "func main() {\n"
+    "  var x, y int\n"
+    "  (x, y) = M.f(3, 4)\n"
+    "  var s string = \"a\\\"b\"\n"
+    "  assert(x == 84)\n"
+    "}\n"
+    "\n"
+    "main()\n";
+
+// Labels allocated by sym_alloc_tmp_sym() are allocated again on load, so
+// they are renamed in the order of appearance.
+static string NormalizeTmpSyms(const string &s) {
+  std::map<string, string> names;
+  string res;
+  size_t pos = 0;
+  while (true) {
+    size_t t = s.find("_t_", pos);
+    if (t == string::npos) {
+      break;
+    }
+    size_t e = t + 3;
+    while (e < s.size() && (isalnum(s[e]) || s[e] == '_')) {
+      ++e;
+    }
+    string name = s.substr(t, e - t);
+    if (names.find(name) == names.end()) {
+      int idx = names.size();
+      names[name] = "_tmp" + std::to_string(idx);
+    }
+    res += s.substr(pos, t - pos) + names[name];
+    pos = e;
+  }
+  return res + s.substr(pos);
+}
+
+static string DumpParseTree(const Method *method) {
+  std::ostringstream os;
+  DumpStream ds(os);
+  method->Dump(ds);
+  return NormalizeTmpSyms(os.str());
+}
+
+static string DumpByteCode(vm::Method *method) {
+  std::ostringstream os;
+  DumpStream ds(os);
+  method->Dump(ds);
+  return NormalizeTmpSyms(os.str());
+}
+
+// Runs the toplevel in a new object, then dumps the bytecode of it and the
+// functions compiled while it runs.
+static string RunAndDump(vm::VM *vm, const Method *tree) {
+  vm::Object *obj = vm->kernel_object_->Clone();
+  compiler::CompileOptions opts;
+  vm::Method *top =
+      compiler::Compiler::CompileParseTree(vm, obj, opts, tree);
+  ASSERT(!top->IsCompileFailure());
+  vm->AddThreadFromMethod(nullptr, obj, top, 0);
+  vm->Run();
+  vm::Method *main = obj->LookupValue(sym_lookup("main"), false)->method_;
+  vm::Object *m = obj->LookupValue(sym_lookup("M"), false)->object_;
+  vm::Method *f = m->LookupValue(sym_lookup("f"), false)->method_;
+  ASSERT(!main->IsCompileFailure() && !f->IsCompileFailure());
+  return DumpByteCode(top) + DumpByteCode(main) + DumpByteCode(f);
+}
+
+static void RemoveDir(const string &dir) {
+  DIR *d = opendir(dir.c_str());
+  if (d == nullptr) {
+    return;
+  }
+  struct dirent *ent;
+  while ((ent = readdir(d)) != nullptr) {
+    string n = ent->d_name;
+    if (n != "." && n != "..") {
+      remove((dir + "/" + n).c_str());
+    }
+  }
+  closedir(d);
+  rmdir(dir.c_str());
+}
+
+static int CountFiles(const string &dir) {
+  int n = 0;
+  DIR *d = opendir(dir.c_str());
+  if (d == nullptr) {
+    return 0;
+  }
+  struct dirent *ent;
+  while ((ent = readdir(d)) != nullptr) {
+    if (ent->d_name[0] != '.') {
+      ++n;
+    }
+  }
+  closedir(d);
+  return n;
+}
+
+void TestParseTreeImage() {
+  FE fe(false, false, "");
+  NodePool::Init();
+  const string fn = "karuta-image-test.karuta";
+  iroha::File::RegisterFile(fn, kSource);
+  const string dir = "/tmp/karuta-image-test-" + std::to_string(getpid());
+  mkdir(dir.c_str(), 0755);
+  vm::VM vm;
+
+  // Parses without the image directory.
+  Env::SetKarutacDir("");
+  vm::Method *parsed = FE::ImportFile(fn, &vm, vm.kernel_object_->Clone());
+  ASSERT(parsed != nullptr);
+  ASSERT(!parsed->IsCompileFailure());
+
+  // Parses again and saves the image.
+  Env::SetKarutacDir(dir);
+  ASSERT(FE::ImportFile(fn, &vm, vm.kernel_object_->Clone()) != nullptr);
+  ASSERT(CountFiles(dir) == 1);
+
+  // Loads the image back. Same tree and same bytecode.
+  FileImage *im = FE::GetFileImage(fn, true);
+  ASSERT(im != nullptr);
+  Method *loaded = ParseTreeImage::Load(im);
+  ASSERT(loaded != nullptr);
+  ASSERT(DumpParseTree(loaded) == DumpParseTree(parsed->GetParseTree()));
+  ASSERT(RunAndDump(&vm, loaded) == RunAndDump(&vm, parsed->GetParseTree()));
+
+  Env::SetKarutacDir("");
+  RemoveDir(dir);
+  NodePool::Release();
+}
+
+}  // namespace fe
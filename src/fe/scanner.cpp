@@ -3,9 +3,12 @@
 #include "fe/scanner.h"
 
 #include <ctype.h>
+#include <fcntl.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <map>
 
@@ -36,9 +39,31 @@ const ScannerInfo *Scanner::s_info;
 Scanner *Scanner::current_scanner_;
 bool Scanner::dbg_scanner;
 
+FileImage::FileImage()
+    : text(nullptr), text_size(0), mapped(nullptr) {}
+
+FileImage::~FileImage() {
+  if (mapped != nullptr) {
+    munmap(mapped, text_size);
+  }
+}
+
+void ScannerInfo::AddKeyword(const char *str, int token) {
+  keywords_[sym_lookup(str)] = token;
+}
+
+int ScannerInfo::LookupKeyword(sym_t sym) const {
+  auto it = keywords_.find(sym);
+  if (it != keywords_.end()) {
+    return it->second;
+  }
+  return 0;
+}
+
 Scanner::Scanner() {
+  text_ = nullptr;
+  text_size_ = 0;
   Reset();
-  token_len_ = 0;
   current_scanner_ = this;
   in_semicolon_ = false;
   in_array_elm_ = false;
@@ -90,7 +115,7 @@ iroha::NumericLiteral Scanner::GetNum() {
   return iroha::NumericLiteral::Parse(string(token_, token_len_));
 }
 
-sym_t Scanner::GetSym() { return sym_lookup(token_); }
+sym_t Scanner::GetSym() { return sym_lookup(token_, token_len_); }
 
 const string *Scanner::GetStr() { return strs_[strs_.size() - 1]; }
 
@@ -100,13 +125,19 @@ void Scanner::GetPosition(ScannerPos *pos) {
   pos->file = file_;
 }
 
-char Scanner::CurChar() { return im_->buf[cur_pos_]; }
+char Scanner::CurChar() {
+  // The mapped text isn't terminated.
+  if (cur_pos_ < text_size_) {
+    return text_[cur_pos_];
+  }
+  return 0;
+}
 
 char Scanner::NextChar() { return ReadAhead(1); }
 
 char Scanner::ReadAhead(int a) {
-  if (cur_pos_ + a < (int)im_->buf.size()) {
-    return im_->buf.data()[cur_pos_ + a];
+  if (cur_pos_ + a < text_size_) {
+    return text_[cur_pos_ + a];
   }
   return -1;
 }
@@ -157,27 +188,16 @@ bool Scanner::IsCommentStart() {
   return false;
 }
 
-bool Scanner::IsEof() { return (cur_pos_ >= im_->buf.size()); }
-
-void Scanner::PushChar(char c) {
-  if (token_len_ > MAX_TOKEN - 2) {
-    // ignore
-    return;
-  }
-  token_[token_len_] = c;
-  token_len_++;
-  token_[token_len_] = 0;
-}
+bool Scanner::IsEof() { return (cur_pos_ >= text_size_); }
 
 int Scanner::ReadNum() {
   ClearToken();
+  int start = cur_pos_;
   bool hex_dec_mode = false;
   if (CurChar() == '0') {
     char c = NextChar();
     if (c == 'x' || c == 'b') {
-      PushChar(CurChar());
       GoAhead();
-      PushChar(CurChar());
       GoAhead();
       if (c == 'x') {
         hex_dec_mode = true;
@@ -187,7 +207,7 @@ int Scanner::ReadNum() {
   while (true) {
     char c = CurChar();
     if (c == '_') {
-      // skip.
+      // Passed to NumericLiteral::Parse() as is.
     } else if (hex_dec_mode) {
       if (!IsHexDec(c)) {
         break;
@@ -197,41 +217,56 @@ int Scanner::ReadNum() {
         break;
       }
     }
-    PushChar(CurChar());
     GoAhead();
   }
+  token_ = text_ + start;
+  token_len_ = cur_pos_ - start;
   return s_info->num_token;
 }
 
 int Scanner::ReadSym() {
   ClearToken();
+  int start = cur_pos_;
   while (IsSymBody(CurChar())) {
-    PushChar(CurChar());
     GoAhead();
   }
+  token_ = text_ + start;
+  token_len_ = cur_pos_ - start;
   return s_info->sym_token;
 }
 
 int Scanner::ReadStr() {
   ClearToken();
   GoAhead();
+  int start = cur_pos_;
+  string *str = nullptr;
   while (1) {
     int c = CurChar();
-    if (c == '\n') {
+    if (c == '\n' || c == 0) {
+      delete str;
       return -1;
     }
     if (c == '\"') {
-      GoAhead();
       break;
     }
     if (c == '\\') {
+      // Copies only strings with escapes.
+      if (str == nullptr) {
+        str = new string(text_ + start, cur_pos_ - start);
+      }
       GoAhead();
       c = CurChar();
+      str->push_back(c);
+    } else if (str != nullptr) {
+      str->push_back(c);
     }
-    PushChar(c);
     GoAhead();
   }
-  strs_.push_back(new string(token_));
+  if (str == nullptr) {
+    str = new string(text_ + start, cur_pos_ - start);
+  }
+  GoAhead();
+  strs_.push_back(str);
   return s_info->str_token;
 }
 
@@ -275,8 +310,8 @@ void Scanner::GoAhead() {
 }
 
 void Scanner::ClearToken() {
+  token_ = nullptr;
   token_len_ = 0;
-  token_[0] = 0;
 }
 
 bool Scanner::IsHexDec(char c) {
@@ -337,17 +372,49 @@ FileImage *Scanner::CreateFileImage(const string &fn, std::istream &is) {
   im->file_name = fn;
   std::ostringstream os;
   os << is.rdbuf();
-  im->buf = os.str() + "\0";
+  im->buf = os.str();
+  im->text = im->buf.data();
+  im->text_size = im->buf.size();
+  return im;
+}
+
+FileImage *Scanner::MapFileImage(const string &fn) {
+  int fd = open(fn.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  void *p = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+  FileImage *im = new FileImage();
+  im->file_name = fn;
+  im->mapped = p;
+  im->text = (const char *)p;
+  im->text_size = st.st_size;
   return im;
 }
 
+ScannerFile *Scanner::GetScannerFile(const string &fn) {
+  return Files.GetScannerFile(fn);
+}
+
 void Scanner::SetFileImage(FileImage *im) {
   Reset();
   im_.reset(im);
   if (im != nullptr) {
     file_ = Files.GetScannerFile(im->file_name);
+    text_ = im->text;
+    text_size_ = im->text_size;
   } else {
     file_ = nullptr;
+    text_ = nullptr;
+    text_size_ = 0;
   }
 }
 
@@ -2,6 +2,8 @@
 #ifndef _fe_scanner_h_
 #define _fe_scanner_h_
 
+#include <unordered_map>
+
 #include "fe/common.h"
 #include "iroha/numeric.h"
 
@@ -9,8 +11,17 @@ namespace fe {
 
 class FileImage {
  public:
+  FileImage();
+  ~FileImage();
+
+  // Points either buf or the mmap-ed file.
+  const char *text;
+  size_t text_size;
+
   string buf;
   string file_name;
+  // Set when the file is mmap-ed.
+  void *mapped;
 };
 
 struct OperatorTableEntry {
@@ -24,12 +35,17 @@ struct OperatorTableEntry {
 // the parser from the scanner.
 class ScannerInfo {
  public:
+  void AddKeyword(const char *str, int token);
   int LookupKeyword(sym_t sym) const;
 
   // parser's token id.
   int num_token;
   int sym_token;
   int str_token;
+
+ private:
+  // Keywords are interned beforehand, so the lookup compares syms.
+  std::unordered_map<sym_t, int> keywords_;
 };
 
 struct ScannerToken {
@@ -45,6 +61,10 @@ class Scanner {
 
   static void Init(const ScannerInfo *si, OperatorTableEntry *ops, bool dbg);
   static FileImage *CreateFileImage(const string &fn, std::istream &is);
+  // Maps the file instead of copying. Returns nullptr if the file can't be
+  // mapped (e.g. empty or not a regular file).
+  static FileImage *MapFileImage(const string &fn);
+  static ScannerFile *GetScannerFile(const string &fn);
 
   void SetFileImage(FileImage *im);
   void ReleaseFileImage();
@@ -76,7 +96,6 @@ class Scanner {
   void GoAhead();
 
   void ClearToken();
-  void PushChar(char c);
 
   int ReadNum();
   int ReadSym();
@@ -92,12 +111,15 @@ class Scanner {
   bool IsSymBody(char c);
 
  private:
-  static const int MAX_TOKEN = 256;
   std::unique_ptr<FileImage> im_;
+  // == im_->text, im_->text_size.
+  const char *text_;
+  int text_size_;
   ScannerFile *file_;
   int cur_pos_;
 
-  char token_[MAX_TOKEN];
+  // Current token in text_.
+  const char *token_;
   int token_len_;
   int ln_;
   bool in_semicolon_;
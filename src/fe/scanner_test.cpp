@@ -0,0 +1,100 @@
+#include "fe/scanner.h"
+
+#include <stdio.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "fe/fe.h"
+#include "fe/scanner_interface.h"
+#include "iroha/test_util.h"
+
+namespace fe {
+
+static long GetTimeUsec() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec * 1000000L + tv.tv_usec;
+}
+
+// Generated code from tools tends to be long flat functions.
+static string GenerateSource(int num_funcs, int num_stmts) {
+  std::ostringstream os;
+  for (int f = 0; f < num_funcs; ++f) {
+    os << "// Generated function " << f << "\n";
+    os << "func gen_" << f << "(a #32, b #32) (#32) {\n";
+    os << "  var acc_" << f << " #32 = 0x1f_ff\n";
+    for (int s = 0; s < num_stmts; ++s) {
+      os << "  if (a > " << s << ") {\n";
+      os << "    acc_" << f << " += (a * b) + " << s * 7 << "\n";
+      os << "  } else {\n";
+      os << "    print(\"gen\\\"" << s << "\")\n";
+      os << "  }\n";
+    }
+    os << "  return acc_" << f << "\n";
+    os << "}\n";
+  }
+  return os.str();
+}
+
+static int ScanAll(FileImage *im, long *num_syms) {
+  std::unique_ptr<Scanner> scanner(ScannerInterface::CreateScanner());
+  scanner->SetFileImage(im);
+  int num_tokens = 0;
+  *num_syms = 0;
+  while (true) {
+    ScannerToken tk;
+    int r = ScannerInterface::GetToken(&tk);
+    if (r < 0) {
+      break;
+    }
+    if (r == Scanner::s_info->sym_token) {
+      ++(*num_syms);
+    }
+    ++num_tokens;
+  }
+  scanner->ReleaseFileImage();
+  return num_tokens;
+}
+
+// Scans the generated source from the copied image and the mapped image.
+static void ScanGeneratedSource(int num_funcs, int num_stmts, bool report) {
+  FE fe(false, false, "");
+  string src = GenerateSource(num_funcs, num_stmts);
+  string fn =
+      "/tmp/karuta-scanner-test-" + std::to_string(getpid()) + ".karuta";
+  {
+    std::ofstream ofs(fn);
+    ofs << src;
+  }
+  std::istringstream is(src);
+  long copied_syms;
+  int copied_tokens = ScanAll(Scanner::CreateFileImage(fn, is), &copied_syms);
+
+  long start = GetTimeUsec();
+  FileImage *im = Scanner::MapFileImage(fn);
+  ASSERT(im != nullptr);
+  long mapped_syms;
+  int mapped_tokens = ScanAll(im, &mapped_syms);
+  long usec = GetTimeUsec() - start;
+  remove(fn.c_str());
+
+  ASSERT(copied_tokens == mapped_tokens);
+  ASSERT(copied_syms == mapped_syms);
+  ASSERT(mapped_tokens > num_funcs * num_stmts);
+  if (!report) {
+    return;
+  }
+  double mb = src.size() / (1024.0 * 1024.0);
+  cout << "Scanner " << mb << "MB " << mapped_tokens << " tokens: "
+       << (mb * 1000000.0 / (usec > 0 ? usec : 1)) << " MB/s\n";
+}
+
+void TestScanner() { ScanGeneratedSource(20, 5, false); }
+
+// About 6MB.
+void BenchmarkScanner() { ScanGeneratedSource(2000, 40, true); }
+
+}  // namespace fe
@@ -3,7 +3,8 @@
     'make_global_settings': [
     ],
     'target_defaults': {
-        'cflags': ['-Wall', '-Wno-sign-compare'],
+        'cflags': ['-Wall', '-Wno-sign-compare', '-pthread'],
+        'ldflags': ['-pthread'],
         'defines': ['PACKAGE="karuta"', 'VERSION="0.6.8wip"'],
         'xcode_settings': {
             'OTHER_CFLAGS': [
@@ -52,8 +53,19 @@
                 '../iroha/src/',
             ],
             'sources': [
+                'base/ring_buffer_test.cpp',
+                'base/sym_test.cpp',
+                'compiler/insn_optimizer_test.cpp',
+                'compiler/loop_unroller_test.cpp',
+                'fe/parse_tree_image_test.cpp',
+                'fe/scanner_test.cpp',
                 'karuta/test_main.cpp',
+                'synth/loop_scheduler_test.cpp',
+                'synth/resource_binder_test.cpp',
+                'synth/synth_cache_test.cpp',
                 'vm/int_array_test.cpp',
+                'vm/member_table_test.cpp',
+                'vm/profile_test.cpp',
             ],
             'dependencies': [
                 ':libkaruta',
@@ -69,6 +81,9 @@
             ],
             'sources': [
                 'base/pool.h',
+                'base/ring_buffer.h',
+                'base/arena.cpp',
+                'base/arena.h',
                 'base/arg_parser.cpp',
                 'base/arg_parser.h',
                 'base/dump_stream.cpp',
@@ -87,12 +102,18 @@
                 'compiler/common.h',
                 'compiler/expr_compiler.cpp',
                 'compiler/expr_compiler.h',
+                'compiler/insn_optimizer.cpp',
+                'compiler/insn_optimizer.h',
                 'compiler/loop_marker.cpp',
                 'compiler/loop_marker.h',
+                'compiler/loop_unroller.cpp',
+                'compiler/loop_unroller.h',
                 'compiler/method_compiler.cpp',
                 'compiler/method_compiler.h',
                 'compiler/reg_checker.cpp',
                 'compiler/reg_checker.h',
+                'compiler/type_checker.cpp',
+                'compiler/type_checker.h',
                 'fe/builder.cpp',
                 'fe/builder.h',
                 'fe/common.cpp',
@@ -105,6 +126,8 @@
                 'fe/expr.h',
                 'fe/fe.cpp',
                 'fe/fe.h',
+                'fe/parse_tree_image.cpp',
+                'fe/parse_tree_image.h',
                 'fe/parser.cpp',
                 'fe/parser.h',
                 'fe/method.cpp',
@@ -130,13 +153,19 @@
                 'karuta/karuta.h',
                 'karuta/karuta_main.cpp',
                 'karuta/karuta_main.h',
+                'synth/channel_graph.cpp',
+                'synth/channel_graph.h',
                 'synth/common.h',
                 'synth/dot_output.cpp',
                 'synth/dot_output.h',
+                'synth/design_holder.cpp',
+                'synth/design_holder.h',
                 'synth/design_synth.cpp',
                 'synth/design_synth.h',
                 'synth/insn_walker.cpp',
                 'synth/insn_walker.h',
+                'synth/loop_scheduler.cpp',
+                'synth/loop_scheduler.h',
                 'synth/method_context.cpp',
                 'synth/method_context.h',
                 'synth/method_expander.cpp',
@@ -153,6 +182,8 @@
                 'synth/object_synth.h',
                 'synth/object_tree.cpp',
                 'synth/object_tree.h',
+                'synth/resource_binder.cpp',
+                'synth/resource_binder.h',
                 'synth/resource_set.cpp',
                 'synth/resource_set.h',
                 'synth/resource_synth.cpp',
@@ -161,6 +192,8 @@
                 'synth/shared_resource_set.h',
                 'synth/synth.cpp',
                 'synth/synth.h',
+                'synth/synth_cache.cpp',
+                'synth/synth_cache.h',
                 'synth/thread_synth.cpp',
                 'synth/thread_synth.h',
                 'synth/tool.cpp',
@@ -180,6 +213,10 @@
                 'vm/executor/decl.h',
                 'vm/executor/executor.cpp',
                 'vm/executor/executor.h',
+                'vm/executor/threaded.cpp',
+                'vm/executor/threaded.h',
+                'vm/frame_stack.cpp',
+                'vm/frame_stack.h',
                 'vm/gc.cpp',
                 'vm/gc.h',
                 'vm/insn_annotator.cpp',
@@ -192,6 +229,8 @@
                 'vm/io_wrapper.h',
                 'vm/mailbox_wrapper.cpp',
                 'vm/mailbox_wrapper.h',
+                'vm/member_table.cpp',
+                'vm/member_table.h',
                 'vm/method.cpp',
                 'vm/method.h',
                 'vm/method_frame.h',
@@ -207,6 +246,8 @@
                 'vm/object_util.h',
                 'vm/opcode.cpp',
                 'vm/opcode.h',
+                'vm/parallel_runner.cpp',
+                'vm/parallel_runner.h',
                 'vm/profile.cpp',
                 'vm/profile.h',
                 'vm/register.cpp',
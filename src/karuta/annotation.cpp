@@ -115,6 +115,14 @@ bool Annotation::ResetPolarity() {
 
 int Annotation::MaxDelayPs() { return LookupIntParam("maxDelayPs", -1); }
 
+int Annotation::GetUnits() { return LookupIntParam("units", 1); }
+
+bool Annotation::IsDataFlowMode() { return LookupIntParam("dataflow", 0) > 0; }
+
+bool Annotation::IsDataFlowShrink() {
+  return LookupIntParam("dataflowShrink", 0) > 0;
+}
+
 bool Annotation::IsAxiMaster() {
   static vector<string> kws = {
       "AxiMaster",
@@ -232,6 +240,12 @@ int Annotation::GetAddrWidth() {
   return 0;
 }
 
+int Annotation::GetBanks() { return LookupIntParam("banks", 1); }
+
+bool Annotation::IsBlockPartition() {
+  return LookupStrParam("partition", "cyclic") == "block";
+}
+
 int Annotation::GetDepth() { return LookupIntParam("depth", 1); }
 
 bool Annotation::IsThreadEntry() {
@@ -251,6 +265,8 @@ bool Annotation::IsPipelineX() {
   return CheckAnnotation(kws);
 }
 
+int Annotation::GetII() { return LookupIntParam("ii", 0); }
+
 bool Annotation::IsSoftThreadEntry() {
   static vector<string> kws = {"SoftThreadEntry", "SoftProcess", "Soft"};
   return CheckAnnotation(kws);
@@ -422,6 +438,21 @@ void Annotation::AddIntParam(const string &key, uint64_t value) {
   }
 }
 
+void Annotation::RemoveParam(const string &key) {
+  vector<AnnotationKeyValue *> &params = params_->params_;
+  for (auto it = params.begin(); it != params.end(); ++it) {
+    if (key == (*it)->key_) {
+      delete *it;
+      params.erase(it);
+      return;
+    }
+  }
+}
+
+void Annotation::GetAllParams(vector<AnnotationKeyValue *> *params) const {
+  *params = params_->params_;
+}
+
 bool Annotation::CheckAnnotation(const vector<string> &kws) {
   // Allows FooBar foobar foo_bar.
   string s = LookupStrParam(annotation::kAnnotationKey, "");
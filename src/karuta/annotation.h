@@ -74,11 +74,19 @@ class Annotation {
   bool IsPipeline();
   // With experimental features.
   bool IsPipelineX();
+  // Target initiation interval of a pipelined loop. 0 if not specified.
+  int GetII();
 
   // resetPolarity 1 or not.
   bool ResetPolarity();
 
   int MaxDelayPs();
+  // Max number of instances of each op resource (op and width).
+  int GetUnits();
+  // Sizes the channels by the profile and reports the bottleneck.
+  bool IsDataFlowMode();
+  // Allows the dataflow mode to shrink channels below the declared depth.
+  bool IsDataFlowShrink();
 
   // For AXI port.
   bool IsAxiMaster();
@@ -92,6 +100,9 @@ class Annotation {
   bool IsExportSramIf();
   // For mailbox.
   bool IsExportMailbox();
+  // For partitioned array.
+  int GetBanks();
+  bool IsBlockPartition();
   // For fifo.
   int GetDepth();
   bool IsNoWait();
@@ -109,6 +120,8 @@ class Annotation {
 
   void AddStrParam(const string &key, const string &value);
   void AddIntParam(const string &key, uint64_t value);
+  void RemoveParam(const string &key);
+  void GetAllParams(vector<AnnotationKeyValue *> *params) const;
 
  private:
   string LookupStrParam(const string &key, const string &dflt);
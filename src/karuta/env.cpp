@@ -22,6 +22,13 @@ bool Env::dot_output_;
 string Env::flavor_;
 bool Env::with_self_shell_;
 bool Env::vcd_output_;
+bool Env::threaded_vm_;
+int Env::num_vm_workers_;
+string Env::profile_output_;
+int Env::profile_period_ = 100;
+string Env::synth_cache_dir_;
+string Env::karutac_dir_;
+string Env::disabled_opt_passes_;
 
 const string &Env::GetVersion() {
   static string v(VERSION);
@@ -141,3 +148,33 @@ void Env::SetWithSelfShell(bool with_self_shell) {
 void Env::EnableVcdOutput(bool en) { vcd_output_ = en; }
 
 bool Env::GetVcdOutput() { return vcd_output_; }
+
+void Env::SetThreadedVM(bool threaded) { threaded_vm_ = threaded; }
+
+bool Env::GetThreadedVM() { return threaded_vm_; }
+
+void Env::SetNumVmWorkers(int num_workers) { num_vm_workers_ = num_workers; }
+
+int Env::GetNumVmWorkers() { return num_vm_workers_; }
+
+void Env::SetProfileOutput(const string &fn) { profile_output_ = fn; }
+
+const string &Env::GetProfileOutput() { return profile_output_; }
+
+void Env::SetProfilePeriod(int period) { profile_period_ = period; }
+
+int Env::GetProfilePeriod() { return profile_period_; }
+
+void Env::SetSynthCacheDir(const string &dir) { synth_cache_dir_ = dir; }
+
+const string &Env::GetSynthCacheDir() { return synth_cache_dir_; }
+
+void Env::SetKarutacDir(const string &dir) { karutac_dir_ = dir; }
+
+const string &Env::GetKarutacDir() { return karutac_dir_; }
+
+void Env::SetDisabledOptPasses(const string &passes) {
+  disabled_opt_passes_ = passes;
+}
+
+const string &Env::GetDisabledOptPasses() { return disabled_opt_passes_; }
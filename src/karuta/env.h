@@ -48,6 +48,21 @@ class Env {
   static void SetWithSelfShell(bool with_self_shell);
   static void EnableVcdOutput(bool en);
   static bool GetVcdOutput();
+  static void SetThreadedVM(bool threaded);
+  static bool GetThreadedVM();
+  static void SetNumVmWorkers(int num_workers);
+  static int GetNumVmWorkers();
+  static void SetProfileOutput(const string &fn);
+  static const string &GetProfileOutput();
+  static void SetProfilePeriod(int period);
+  static int GetProfilePeriod();
+  static void SetSynthCacheDir(const string &dir);
+  static const string &GetSynthCacheDir();
+  static void SetKarutacDir(const string &dir);
+  static const string &GetKarutacDir();
+  // Flag chars of the byte code optimizer passes to skip.
+  static void SetDisabledOptPasses(const string &passes);
+  static const string &GetDisabledOptPasses();
 
  private:
   static const char *karuta_dir_;
@@ -64,6 +79,13 @@ class Env {
   static string flavor_;
   static bool with_self_shell_;
   static bool vcd_output_;
+  static bool threaded_vm_;
+  static int num_vm_workers_;
+  static string profile_output_;
+  static int profile_period_;
+  static string synth_cache_dir_;
+  static string karutac_dir_;
+  static string disabled_opt_passes_;
 };
 
 #endif  // _karuta_env_h_
@@ -26,6 +26,7 @@
 #include "iroha/iroha_main.h"
 #include "iroha/numeric.h"
 #include "karuta/karuta.h"
+#include "synth/synth_cache.h"
 
 KarutaMain::KarutaMain()
     : dbg_scanner_(false),
@@ -45,19 +46,28 @@ void KarutaMain::PrintUsage() {
        << "   -l\n"
        << "   -l=[modules]\n"
        << "   --compile\n"
+       << "   --disable_opt [passes]\n"
        << "   --duration\n"
        << "   --dot\n"
        << "   --iroha_binary [iroha]\n"
+       << "   --karutac_dir [dir]\n"
        << "   --module_prefix [mod]\n"
        << "   --output_marker [marker]\n"
        << "   --flavor [flavor]\n"
        << "   --print_exit_status\n"
+       << "   --profile [file]\n"
+       << "   --profile_period [n]\n"
        << "   --root [path]\n"
        << "   --run\n"
+       << "   --synth_cache [dir]\n"
        << "   --timeout [ms]\n"
        << "   --vanilla\n"
        << "   --vcd\n"
        << "   --version\n"
+       << "   --vm_engine [switch|threaded]\n"
+       << "   --vm_workers [n]\n"
+       << "     Runs only the insns at the beginning of each pass which\n"
+       << "     calculate values in registers in parallel.\n"
        << "   --with_shell\n"
        << "\n"
        << " Please see https://karuta.readthedocs.io/en/latest/ or "
@@ -122,13 +132,20 @@ void KarutaMain::ParseArgs(int argc, char **argv, ArgParser *parser) {
   parser->RegisterBoolFlag("vanilla", nullptr);
   parser->RegisterBoolFlag("vcd", nullptr);
   parser->RegisterBoolFlag("version", "help");
+  parser->RegisterValueFlag("disable_opt", nullptr);
   parser->RegisterValueFlag("duration", nullptr);
   parser->RegisterValueFlag("iroha_binary", nullptr);
+  parser->RegisterValueFlag("karutac_dir", nullptr);
   parser->RegisterValueFlag("module_prefix", nullptr);
   parser->RegisterValueFlag("output_marker", nullptr);
   parser->RegisterValueFlag("flavor", nullptr);
+  parser->RegisterValueFlag("profile", nullptr);
+  parser->RegisterValueFlag("profile_period", nullptr);
   parser->RegisterValueFlag("root", nullptr);
+  parser->RegisterValueFlag("synth_cache", nullptr);
   parser->RegisterValueFlag("timeout", nullptr);
+  parser->RegisterValueFlag("vm_engine", nullptr);
+  parser->RegisterValueFlag("vm_workers", nullptr);
   parser->RegisterModeArg("compile", nullptr);
   parser->RegisterModeArg("run", nullptr);
   parser->RegisterModeArg("sim", nullptr);
@@ -183,6 +200,9 @@ int KarutaMain::main(int argc, char **argv) {
   if (args.GetFlagValue("iroha_binary", &arg)) {
     Env::SetIrohaBinPath(arg);
   }
+  if (args.GetFlagValue("disable_opt", &arg)) {
+    Env::SetDisabledOptPasses(arg);
+  }
   if (args.GetFlagValue("duration", &arg)) {
     long d = iroha::Util::AtoULL(arg);
     Env::SetDuration(d);
@@ -196,6 +216,24 @@ int KarutaMain::main(int argc, char **argv) {
   if (args.GetBoolFlag("vcd", false)) {
     Env::EnableVcdOutput(true);
   }
+  if (args.GetFlagValue("vm_engine", &arg)) {
+    Env::SetThreadedVM(arg == "threaded");
+  }
+  if (args.GetFlagValue("vm_workers", &arg)) {
+    Env::SetNumVmWorkers(atoi(arg.c_str()));
+  }
+  if (args.GetFlagValue("profile", &arg)) {
+    Env::SetProfileOutput(arg);
+  }
+  if (args.GetFlagValue("profile_period", &arg)) {
+    Env::SetProfilePeriod(atoi(arg.c_str()));
+  }
+  if (args.GetFlagValue("karutac_dir", &arg)) {
+    Env::SetKarutacDir(arg);
+  }
+  if (args.GetFlagValue("synth_cache", &arg)) {
+    Env::SetSynthCacheDir(arg);
+  }
 
   if (timeout_) {
     InstallTimeout();
@@ -220,6 +258,10 @@ int KarutaMain::main(int argc, char **argv) {
   if (print_exit_status_) {
     // Used to confirm this program was finished normally.
     // (without SEGV and so on)
+    if (synth::SynthCache::IsEnabled()) {
+      cout << "KARUTA SYNTH CACHE: hits=" << synth::SynthCache::GetNumHits()
+           << " misses=" << synth::SynthCache::GetNumMisses() << "\n";
+    }
     cout << "KARUTA DONE: " << exit_status << "\n";
   }
   return 0;
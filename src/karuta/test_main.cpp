@@ -1,8 +1,53 @@
+#include <string.h>
+
+void TestRingBuffer();
+void TestSymTable();
+
+namespace compiler {
+void TestInsnOptimizer();
+void TestLoopUnroller();
+}  // namespace compiler
+
+namespace fe {
+void TestParseTreeImage();
+void TestScanner();
+void BenchmarkScanner();
+}  // namespace fe
+
+namespace synth {
+void TestLoopScheduler();
+void TestResourceBinder();
+void TestSynthCache();
+}  // namespace synth
+
 namespace vm {
 void TestIntArray();
+void TestDenseIntArray();
+void TestIntArrayBank();
+void TestMemberTable();
+void TestProfile();
+void BenchmarkIntArray();
 }  // namespace vm
 
 int main(int argc, char **argv) {
+  TestRingBuffer();
+  TestSymTable();
   vm::TestIntArray();
+  vm::TestDenseIntArray();
+  vm::TestIntArrayBank();
+  vm::TestMemberTable();
+  vm::TestProfile();
+  fe::TestScanner();
+  fe::TestParseTreeImage();
+  compiler::TestInsnOptimizer();
+  compiler::TestLoopUnroller();
+  synth::TestLoopScheduler();
+  synth::TestResourceBinder();
+  synth::TestSynthCache();
+  // Takes seconds and writes a large file to /tmp.
+  if (argc > 1 && !strcmp(argv[1], "--benchmark")) {
+    vm::BenchmarkIntArray();
+    fe::BenchmarkScanner();
+  }
   return 0;
 }
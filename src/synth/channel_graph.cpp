@@ -0,0 +1,158 @@
+#include "synth/channel_graph.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "base/status.h"
+#include "base/stl_util.h"
+#include "base/util.h"
+#include "synth/design_synth.h"
+#include "synth/object_synth.h"
+#include "synth/shared_resource_set.h"
+#include "synth/thread_synth.h"
+#include "vm/channel_wrapper.h"
+#include "vm/vm.h"
+
+namespace synth {
+
+ChannelGraph::ChannelGraph(DesignSynth *design_synth, bool shrink)
+    : design_synth_(design_synth), shrink_(shrink) {}
+
+ChannelGraph::~ChannelGraph() { STLDeleteValues(&channels_); }
+
+void ChannelGraph::Build() {
+  SharedResourceSet *sres_set = design_synth_->GetSharedResourceSet();
+  vector<vm::Object *> objs;
+  sres_set->GetChannels(&objs);
+  for (vm::Object *obj : objs) {
+    SharedResource *sres = sres_set->GetByObj(obj, nullptr);
+    Channel *ch = new Channel;
+    ch->obj_ = obj;
+    ch->name_ = vm::ChannelWrapper::ChannelName(obj);
+    // Keeps the scan order to make the output stable.
+    for (ThreadSynth *thr : sres->ordered_accessors_) {
+      if (sres->writers_.find(thr) != sres->writers_.end() &&
+          std::find(ch->writers_.begin(), ch->writers_.end(), thr) ==
+              ch->writers_.end()) {
+        ch->writers_.push_back(thr);
+      }
+      if (sres->readers_.find(thr) != sres->readers_.end() &&
+          std::find(ch->readers_.begin(), ch->readers_.end(), thr) ==
+              ch->readers_.end()) {
+        ch->readers_.push_back(thr);
+      }
+    }
+    SizeDepth(ch);
+    channels_.push_back(ch);
+    obj_channels_[obj] = ch;
+  }
+  std::stable_sort(
+      channels_.begin(), channels_.end(),
+      [](const Channel *a, const Channel *b) { return a->name_ < b->name_; });
+}
+
+void ChannelGraph::SizeDepth(Channel *ch) {
+  ch->declared_depth_ = vm::ChannelWrapper::ChannelDepth(ch->obj_);
+  ch->depth_ = ch->declared_depth_;
+  vm::Profile *profile = design_synth_->GetVM()->GetProfile();
+  ch->has_profile_ = profile->GetChannelProfile(
+      vm::ChannelWrapper::ChannelId(ch->obj_), &ch->profile_);
+  if (!ch->has_profile_) {
+    return;
+  }
+  if (ch->profile_.full_ > 0) {
+    ch->depth_ = ::Util::RoundUp2(2 * ch->declared_depth_);
+    return;
+  }
+  if (!shrink_) {
+    return;
+  }
+  int depth = ::Util::RoundUp2(ch->profile_.max_occupancy_);
+  if (depth < 1) {
+    depth = 1;
+  }
+  if (depth < ch->depth_) {
+    ch->depth_ = depth;
+  }
+}
+
+void ChannelGraph::Report() {
+  // Number of blocked reads and writes of each thread.
+  vector<ThreadSynth *> thrs;
+  map<ThreadSynth *, long> blocks;
+  for (Channel *ch : channels_) {
+    if (!ch->has_profile_) {
+      std::ostringstream os;
+      os << "Channel " << ch->name_ << " has no profile. depth=" << ch->depth_;
+      design_synth_->Report(os.str());
+      continue;
+    }
+    const vm::ChannelProfile &cp = ch->profile_;
+    std::ostringstream os;
+    os << "Channel " << ch->name_ << " (" << ThreadNames(ch->writers_)
+       << " -> " << ThreadNames(ch->readers_) << "): depth=" << ch->depth_
+       << " (declared=" << ch->declared_depth_
+       << ", max occupancy=" << cp.max_occupancy_ << ", writes=" << cp.writes_
+       << ", full=" << cp.full_ << ", empty=" << cp.empty_ << ")";
+    design_synth_->Report(os.str());
+    if (cp.full_ > 0) {
+      std::ostringstream fos;
+      fos << "Channel " << ch->name_ << " got full " << cp.full_
+          << " times. The depth is increased to " << ch->depth_ << ".";
+      design_synth_->Report(fos.str());
+    }
+    for (ThreadSynth *thr : ch->writers_) {
+      if (blocks.find(thr) == blocks.end()) {
+        thrs.push_back(thr);
+      }
+      blocks[thr] += cp.full_;
+    }
+    for (ThreadSynth *thr : ch->readers_) {
+      if (blocks.find(thr) == blocks.end()) {
+        thrs.push_back(thr);
+      }
+      blocks[thr] += cp.empty_;
+    }
+  }
+  if (thrs.size() < 2) {
+    return;
+  }
+  ThreadSynth *bottleneck = nullptr;
+  for (ThreadSynth *thr : thrs) {
+    if (bottleneck == nullptr || blocks[thr] < blocks[bottleneck]) {
+      bottleneck = thr;
+    }
+  }
+  std::ostringstream os;
+  os << "Throughput bottleneck of the channels: " << ThreadName(bottleneck)
+     << " (blocked " << blocks[bottleneck] << " times)";
+  design_synth_->Report(os.str());
+}
+
+int ChannelGraph::GetDepth(vm::Object *ch) {
+  auto it = obj_channels_.find(ch);
+  if (it == obj_channels_.end()) {
+    return vm::ChannelWrapper::ChannelDepth(ch);
+  }
+  return it->second->depth_;
+}
+
+string ChannelGraph::ThreadNames(const vector<ThreadSynth *> &thrs) {
+  if (thrs.empty()) {
+    return "-";
+  }
+  string s;
+  for (ThreadSynth *thr : thrs) {
+    if (!s.empty()) {
+      s += ",";
+    }
+    s += ThreadName(thr);
+  }
+  return s;
+}
+
+string ChannelGraph::ThreadName(ThreadSynth *thr) {
+  return thr->GetObjectSynth()->GetName() + "." + thr->GetEntryMethodName();
+}
+
+}  // namespace synth
@@ -0,0 +1,59 @@
+// -*- C++ -*-
+#ifndef _synth_channel_graph_h_
+#define _synth_channel_graph_h_
+
+#include <map>
+
+#include "synth/common.h"
+#include "vm/profile.h"
+
+using std::map;
+
+namespace synth {
+
+// Threads connected by channels for the dataflow mode
+// (setSynthParam("dataflow", 1)).
+//
+// The depth of each channel which got full while the design runs on the
+// VM is doubled (rounded up to a power of 2). Other channels keep the
+// declared depth, unless setSynthParam("dataflowShrink", 1) allows them to
+// shrink to the max occupancy recorded in the profile. The thread blocked
+// least on the channels is reported as the bottleneck of the throughput,
+// since the other threads wait for it to read or write.
+class ChannelGraph {
+ public:
+  // shrink allows channels to be shallower than the declared depth.
+  ChannelGraph(DesignSynth *design_synth, bool shrink);
+  ~ChannelGraph();
+
+  // Called after the scan pass.
+  void Build();
+  void Report();
+  int GetDepth(vm::Object *ch);
+
+ private:
+  class Channel {
+   public:
+    vm::Object *obj_;
+    string name_;
+    vector<ThreadSynth *> writers_;
+    vector<ThreadSynth *> readers_;
+    int declared_depth_;
+    int depth_;
+    bool has_profile_;
+    vm::ChannelProfile profile_;
+  };
+
+  void SizeDepth(Channel *ch);
+  string ThreadNames(const vector<ThreadSynth *> &thrs);
+  string ThreadName(ThreadSynth *thr);
+
+  DesignSynth *design_synth_;
+  bool shrink_;
+  vector<Channel *> channels_;
+  map<vm::Object *, Channel *> obj_channels_;
+};
+
+}  // namespace synth
+
+#endif  // _synth_channel_graph_h_
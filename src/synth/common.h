@@ -27,6 +27,7 @@ using namespace iroha;
 
 namespace vm {
 class Insn;
+class IntArray;
 class Method;
 class Object;
 class Register;
@@ -35,6 +36,7 @@ class Value;
 }  // namespace vm
 
 namespace synth {
+class ChannelGraph;
 class DesignSynth;
 class InsnWalker;
 class MethodContext;
@@ -0,0 +1,66 @@
+#include "synth/design_holder.h"
+
+#include "iroha/i_design.h"
+#include "iroha/iroha.h"
+#include "vm/object.h"
+
+namespace synth {
+
+static const char *kDesignHolderObjectKey = "design";
+
+class DesignHolderData : public vm::ObjectSpecificData {
+ public:
+  DesignHolderData(vm::Object *owner, IDesign *design)
+      : owner_(owner), design_(design) {}
+
+  virtual const char *ObjectTypeKey() { return kDesignHolderObjectKey; }
+  // Same as plain objects.
+  virtual bool Compare(vm::Object *obj) { return owner_ == obj; }
+
+  vm::Object *owner_;
+  std::unique_ptr<IDesign> design_;
+  // Declared after design_ to be destructed before it.
+  std::unique_ptr<OptAPI> optimizer_;
+};
+
+static DesignHolderData *GetData(vm::Object *obj) {
+  if (obj->ObjectTypeKey() != kDesignHolderObjectKey) {
+    return nullptr;
+  }
+  return (DesignHolderData *)obj->object_specific_.get();
+}
+
+bool DesignHolder::SetDesign(vm::Object *obj, IDesign *design) {
+  if (obj->object_specific_.get() != nullptr && GetData(obj) == nullptr) {
+    return false;
+  }
+  obj->object_specific_.reset(new DesignHolderData(obj, design));
+  return true;
+}
+
+IDesign *DesignHolder::GetDesign(vm::Object *obj) {
+  DesignHolderData *data = GetData(obj);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return data->design_.get();
+}
+
+OptAPI *DesignHolder::GetOptimizer(vm::Object *obj) {
+  DesignHolderData *data = GetData(obj);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  if (data->optimizer_.get() == nullptr) {
+    data->optimizer_.reset(Iroha::CreateOptimizer(data->design_.get()));
+  }
+  return data->optimizer_.get();
+}
+
+void DesignHolder::ClearDesign(vm::Object *obj) {
+  if (GetData(obj) != nullptr) {
+    obj->object_specific_.reset();
+  }
+}
+
+}  // namespace synth
@@ -0,0 +1,29 @@
+// -*- C++ -*-
+#ifndef _synth_design_holder_h_
+#define _synth_design_holder_h_
+
+#include "synth/common.h"
+
+namespace iroha {
+class OptAPI;
+}  // namespace iroha
+
+namespace synth {
+
+// Keeps the IDesign synthesized from an object in the object, so that
+// following optimization passes and HDL output can be done in process
+// without writing and parsing the IR file.
+class DesignHolder {
+ public:
+  // Takes the ownership of design. Returns false (and doesn't take it)
+  // if the object already has other object specific data.
+  static bool SetDesign(vm::Object *obj, IDesign *design);
+  // nullptr if the object doesn't have a design.
+  static IDesign *GetDesign(vm::Object *obj);
+  static iroha::OptAPI *GetOptimizer(vm::Object *obj);
+  static void ClearDesign(vm::Object *obj);
+};
+
+}  // namespace synth
+
+#endif  // _synth_design_holder_h_
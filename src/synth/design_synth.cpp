@@ -8,11 +8,13 @@
 #include "iroha/i_design.h"
 #include "iroha/iroha.h"
 #include "karuta/annotation.h"
+#include "synth/channel_graph.h"
 #include "synth/dot_output.h"
 #include "synth/object_attr_names.h"
 #include "synth/object_synth.h"
 #include "synth/object_tree.h"
 #include "synth/shared_resource_set.h"
+#include "vm/channel_wrapper.h"
 #include "vm/object.h"
 
 namespace synth {
@@ -71,16 +73,25 @@ bool DesignSynth::SynthObjects() {
   }
   DeterminePrimaryThread();
   shared_resources_->DetermineOwnerThreadAll();
+  Annotation *an = GetSynthParams();
+  if (an != nullptr && an->IsDataFlowMode()) {
+    channel_graph_.reset(new ChannelGraph(this, an->IsDataFlowShrink()));
+    channel_graph_->Build();
+    channel_graph_->Report();
+  }
   // Pass 2: Synth.
   if (!SynthObjectsAll(root_synth)) {
     return false;
   }
   shared_resources_->ResolveResourceAccessors();
   shared_resources_->ResolveAccessorDistanceAll(this);
-  for (auto it : obj_synth_map_) {
-    ObjectSynth *obj_synth = it.second;
-    obj_synth->ResolveTableCallsAll();
+  // Resolving a call may create an ObjectSynth for the callee, but it
+  // doesn't have any calls to resolve.
+  size_t num_synthes = obj_synth_order_.size();
+  for (size_t i = 0; i < num_synthes; ++i) {
+    obj_synth_order_[i]->ResolveTableCallsAll();
   }
+  ScheduleLoopsAll();
   return true;
 }
 
@@ -95,10 +106,22 @@ bool DesignSynth::SynthObjectsAll(ObjectSynth *root_synth) {
   return true;
 }
 
+void DesignSynth::ScheduleLoopsAll() {
+  // In the creation order of the objects to keep the output stable.
+  for (ObjectSynth *osynth : obj_synth_order_) {
+    osynth->ScheduleLoops();
+  }
+  for (ObjectSynth *osynth : obj_synth_order_) {
+    osynth->ReportLoops();
+  }
+}
+
 vm::VM *DesignSynth::GetVM() { return vm_; }
 
 IDesign *DesignSynth::GetIDesign() { return i_design_.get(); }
 
+IDesign *DesignSynth::ReleaseIDesign() { return i_design_.release(); }
+
 ObjectSynth *DesignSynth::GetObjectSynth(vm::Object *obj, bool cr) {
   auto it = obj_synth_map_.find(obj);
   if (it != obj_synth_map_.end()) {
@@ -112,6 +135,7 @@ ObjectSynth *DesignSynth::GetObjectSynth(vm::Object *obj, bool cr) {
   CHECK(!name.empty());
   ObjectSynth *osynth = new ObjectSynth(obj, this, is_root, name);
   obj_synth_map_[obj] = osynth;
+  obj_synth_order_.push_back(osynth);
   return osynth;
 }
 
@@ -127,15 +151,31 @@ int DesignSynth::GetObjectDistance(vm::Object *src, vm::Object *dst) {
   return obj_tree_->GetDistance(src, dst);
 }
 
+int DesignSynth::GetChannelDepth(vm::Object *ch) {
+  if (channel_graph_.get() == nullptr) {
+    return vm::ChannelWrapper::ChannelDepth(ch);
+  }
+  return channel_graph_->GetDepth(ch);
+}
+
+void DesignSynth::Report(const string &msg) {
+  Status::os(Status::INFO) << msg;
+  MessageFlush::Get(Status::INFO);
+  reports_.push_back(msg);
+}
+
+const vector<string> &DesignSynth::GetReports() const { return reports_; }
+
 bool DesignSynth::ScanObjs() {
   int num_scan;
   // Loop until every objects stops to request rescan.
   do {
     num_scan = 0;
-    map<vm::Object *, ObjectSynth *> m = obj_synth_map_;
-    for (auto it : m) {
+    // Objects found during this round are scanned in the next round.
+    size_t num_synthes = obj_synth_order_.size();
+    for (size_t i = 0; i < num_synthes; ++i) {
       bool ok = true;
-      ObjectSynth *osynth = it.second;
+      ObjectSynth *osynth = obj_synth_order_[i];
       if (osynth->Scan(&ok)) {
         ++num_scan;
       }
@@ -160,8 +200,8 @@ void DesignSynth::CollectScanRootObjRec(vm::Object *obj) {
 }
 
 void DesignSynth::DeterminePrimaryThread() {
-  for (auto it : obj_synth_map_) {
-    it.second->DeterminePrimaryThread();
+  for (ObjectSynth *osynth : obj_synth_order_) {
+    osynth->DeterminePrimaryThread();
   }
 }
 
@@ -174,15 +214,19 @@ bool DesignSynth::GetResetPolarity(Annotation *an) {
   return an->ResetPolarity();
 }
 
-void DesignSynth::SetSynthParams() {
-  iroha::ResourceParams *params = i_design_->GetParams();
-
+Annotation *DesignSynth::GetSynthParams() {
   sym_t synth_params = sym_lookup(kSynthParams);
-  Annotation *an = nullptr;
   vm::Value *value = root_obj_->LookupValue(synth_params, false);
   if (value != nullptr && value->type_ == vm::Value::ANNOTATION) {
-    an = value->annotation_;
+    return value->annotation_;
   }
+  return nullptr;
+}
+
+void DesignSynth::SetSynthParams() {
+  iroha::ResourceParams *params = i_design_->GetParams();
+
+  Annotation *an = GetSynthParams();
   params->SetResetPolarity(GetResetPolarity(an));
   if (an != nullptr) {
     int d = an->MaxDelayPs();
@@ -18,18 +18,28 @@ class DesignSynth {
 
   vm::VM *GetVM();
   IDesign *GetIDesign();
+  // Caller takes the ownership.
+  IDesign *ReleaseIDesign();
   ObjectSynth *GetObjectSynth(vm::Object *obj, bool cr);
   SharedResourceSet *GetSharedResourceSet();
   string GetObjectName(vm::Object *obj);
   int GetObjectDistance(vm::Object *src, vm::Object *dst);
+  // Depth sized by ChannelGraph in the dataflow mode.
+  int GetChannelDepth(vm::Object *ch);
+  // Shows an INFO message about the design to the user. The reports are
+  // also stored in SynthCache to be shown again on a hit.
+  void Report(const string &msg);
+  const vector<string> &GetReports() const;
 
  private:
   bool SynthObjects();
   bool SynthObjectsAll(ObjectSynth *root_synth);
+  void ScheduleLoopsAll();
   void CollectObjSynthRec(ObjectSynth *osynth, vector<ObjectSynth *> *synthes);
   bool ScanObjs();
   void CollectScanRootObjRec(vm::Object *obj);
   void DeterminePrimaryThread();
+  Annotation *GetSynthParams();
   bool GetResetPolarity(Annotation *an);
   void SetSynthParams();
 
@@ -38,7 +48,13 @@ class DesignSynth {
   std::unique_ptr<IDesign> i_design_;
   std::unique_ptr<SharedResourceSet> shared_resources_;
   std::unique_ptr<ObjectTree> obj_tree_;
+  std::unique_ptr<ChannelGraph> channel_graph_;
   std::map<vm::Object *, ObjectSynth *> obj_synth_map_;
+  // Same ObjectSynth-s as obj_synth_map_ in the creation order. Passes
+  // over every object walk this instead of the map so that the order of
+  // created IR objects doesn't depend on addresses of vm::Object-s.
+  vector<ObjectSynth *> obj_synth_order_;
+  vector<string> reports_;
 };
 
 }  // namespace synth
@@ -0,0 +1,220 @@
+#include "synth/loop_scheduler.h"
+
+#include <map>
+
+#include "iroha/iroha.h"
+#include "synth/method_context.h"
+
+using std::map;
+
+namespace synth {
+
+LoopScheduler::LoopScheduler(MethodContext *context, int start, int end)
+    : context_(context),
+      start_(start),
+      end_(end),
+      res_mii_(1),
+      rec_mii_(1),
+      failure_(NONE) {}
+
+int LoopScheduler::Schedule() {
+  if (!CollectOps()) {
+    failure_ = HAS_BRANCH;
+    return -1;
+  }
+  if (ops_.empty()) {
+    return 1;
+  }
+  CollectDeps();
+  ComputeResMII();
+  ComputeRecMII();
+  for (int ii = std::max(res_mii_, rec_mii_); ii <= GetMaxII(); ++ii) {
+    if (TrySchedule(ii)) {
+      return ii;
+    }
+  }
+  failure_ = NO_II;
+  return -1;
+}
+
+LoopScheduler::Failure LoopScheduler::GetFailure() const { return failure_; }
+
+int LoopScheduler::GetResMII() const { return res_mii_; }
+
+int LoopScheduler::GetRecMII() const { return rec_mii_; }
+
+int LoopScheduler::GetMaxII() const { return ops_.size() * 2; }
+
+bool LoopScheduler::CollectOps() {
+  map<IState *, int> state_index;
+  for (int i = start_; i < end_; ++i) {
+    state_index[context_->states_[i]->state_] = i;
+  }
+  for (int i = start_; i < end_; ++i) {
+    IState *st = context_->states_[i]->state_;
+    set<IResource *> resources;
+    set<IRegister *> inputs;
+    set<IRegister *> outputs;
+    for (IInsn *insn : st->insns_) {
+      IResource *res = insn->GetResource();
+      // Read data from SRAM doesn't use the port.
+      if (!IsSharable(res) &&
+          insn->GetOperand() != iroha::operand::kSramReadData) {
+        resources.insert(res);
+      }
+      inputs.insert(insn->inputs_.begin(), insn->inputs_.end());
+      outputs.insert(insn->outputs_.begin(), insn->outputs_.end());
+      if (insn->target_states_.size() > 1) {
+        // Only the exit of the loop is allowed.
+        for (IState *target : insn->target_states_) {
+          auto it = state_index.find(target);
+          if (it != state_index.end() && it->second != i + 1) {
+            return false;
+          }
+        }
+      }
+    }
+    if (resources.empty() && inputs.empty() && outputs.empty()) {
+      continue;
+    }
+    ops_.push_back(st);
+    op_resources_.push_back(resources);
+    op_inputs_.push_back(inputs);
+    op_outputs_.push_back(outputs);
+  }
+  return true;
+}
+
+void LoopScheduler::CollectDeps() {
+  int num_ops = ops_.size();
+  for (int i = 0; i < num_ops; ++i) {
+    for (int j = 0; j < num_ops; ++j) {
+      int distance = (i < j) ? 0 : 1;
+      for (IRegister *reg : op_outputs_[i]) {
+        if (op_inputs_[j].count(reg) > 0) {
+          // Read after write.
+          AddDep(i, j, 1, distance);
+        }
+        if (i != j && op_outputs_[j].count(reg) > 0) {
+          // Write after write.
+          AddDep(i, j, 1, distance);
+        }
+      }
+      if (i == j) {
+        continue;
+      }
+      for (IRegister *reg : op_inputs_[i]) {
+        if (op_outputs_[j].count(reg) > 0) {
+          // Write after read. The register keeps the value until the end
+          // of the cycle.
+          AddDep(i, j, 0, distance);
+        }
+      }
+    }
+  }
+}
+
+void LoopScheduler::AddDep(int from, int to, int latency, int distance) {
+  Dep dep;
+  dep.from = from;
+  dep.to = to;
+  dep.latency = latency;
+  dep.distance = distance;
+  deps_.push_back(dep);
+}
+
+void LoopScheduler::ComputeResMII() {
+  map<IResource *, int> uses;
+  for (auto &resources : op_resources_) {
+    for (IResource *res : resources) {
+      int n = ++uses[res];
+      if (n > res_mii_) {
+        res_mii_ = n;
+      }
+    }
+  }
+}
+
+void LoopScheduler::ComputeRecMII() {
+  // Longest paths in an iteration. Ops are in the topological order.
+  int num_ops = ops_.size();
+  vector<vector<int> > longest(num_ops, vector<int>(num_ops, -1));
+  for (int i = 0; i < num_ops; ++i) {
+    longest[i][i] = 0;
+  }
+  for (const Dep &dep : deps_) {
+    if (dep.distance == 0 && dep.latency > longest[dep.from][dep.to]) {
+      longest[dep.from][dep.to] = dep.latency;
+    }
+  }
+  for (int k = 0; k < num_ops; ++k) {
+    for (int i = 0; i < k; ++i) {
+      if (longest[i][k] < 0) {
+        continue;
+      }
+      for (int j = k + 1; j < num_ops; ++j) {
+        if (longest[k][j] >= 0 &&
+            longest[i][k] + longest[k][j] > longest[i][j]) {
+          longest[i][j] = longest[i][k] + longest[k][j];
+        }
+      }
+    }
+  }
+  for (const Dep &dep : deps_) {
+    if (dep.distance == 0 || longest[dep.to][dep.from] < 0) {
+      continue;
+    }
+    int ii = longest[dep.to][dep.from] + dep.latency;
+    if (ii > rec_mii_) {
+      rec_mii_ = ii;
+    }
+  }
+}
+
+bool LoopScheduler::TrySchedule(int ii) {
+  int num_ops = ops_.size();
+  vector<int> times(num_ops, 0);
+  // Modulo reservation table.
+  vector<set<IResource *> > mrt(ii);
+  for (int i = 0; i < num_ops; ++i) {
+    int t = 0;
+    for (const Dep &dep : deps_) {
+      if (dep.to == i && dep.distance == 0 &&
+          times[dep.from] + dep.latency > t) {
+        t = times[dep.from] + dep.latency;
+      }
+    }
+    int limit = t + ii;
+    for (; t < limit; ++t) {
+      set<IResource *> &slot = mrt[t % ii];
+      bool ok = true;
+      for (IResource *res : op_resources_[i]) {
+        if (slot.count(res) > 0) {
+          ok = false;
+        }
+      }
+      if (ok) {
+        break;
+      }
+    }
+    if (t == limit) {
+      return false;
+    }
+    times[i] = t;
+    mrt[t % ii].insert(op_resources_[i].begin(), op_resources_[i].end());
+  }
+  for (const Dep &dep : deps_) {
+    if (times[dep.to] + dep.distance * ii < times[dep.from] + dep.latency) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopScheduler::IsSharable(IResource *res) {
+  const string &name = res->GetClass()->GetName();
+  return (name == resource::kSet || name == resource::kTransition ||
+          name == resource::kPseudo);
+}
+
+}  // namespace synth
@@ -0,0 +1,80 @@
+// -*- C++ -*-
+#ifndef _synth_loop_scheduler_h_
+#define _synth_loop_scheduler_h_
+
+#include "synth/common.h"
+
+#include <set>
+
+using std::set;
+
+namespace synth {
+
+// Computes a modulo schedule of the body of a loop annotated with
+// @Pipeline() to find the initiation interval (II) of the pipeline.
+//
+// Each state of the body which does something is an operation taking a
+// cycle. Resources except assignments and transitions (operators, ports
+// of arrays and so on) can be used once in each slot of the modulo
+// reservation table. II starts from max(ResMII, RecMII) and is increased
+// until all the operations and the dependencies between the iterations
+// fit in it.
+//
+// The result is reported to the user as an advisory lower bound. The states
+// are not rewritten here and the pipelined table is built by the Iroha loop
+// pipeliner, which may end up with a larger II.
+class LoopScheduler {
+ public:
+  // States of the loop body are [start, end) of the context.
+  LoopScheduler(MethodContext *context, int start, int end);
+
+  enum Failure {
+    NONE,
+    // The body has branches other than the exit of the loop.
+    HAS_BRANCH,
+    // No II up to GetMaxII() satisfies the dependencies.
+    NO_II,
+  };
+
+  // Returns II or -1 if the body can't be pipelined. GetFailure() tells
+  // the reason.
+  int Schedule();
+  Failure GetFailure() const;
+  int GetResMII() const;
+  int GetRecMII() const;
+  int GetMaxII() const;
+
+ private:
+  // t[to] + distance * II >= t[from] + latency.
+  class Dep {
+   public:
+    int from;
+    int to;
+    int latency;
+    int distance;
+  };
+
+  bool CollectOps();
+  void CollectDeps();
+  void AddDep(int from, int to, int latency, int distance);
+  void ComputeResMII();
+  void ComputeRecMII();
+  bool TrySchedule(int ii);
+  static bool IsSharable(IResource *res);
+
+  MethodContext *context_;
+  int start_;
+  int end_;
+  vector<IState *> ops_;
+  vector<set<IResource *> > op_resources_;
+  vector<set<IRegister *> > op_inputs_;
+  vector<set<IRegister *> > op_outputs_;
+  vector<Dep> deps_;
+  int res_mii_;
+  int rec_mii_;
+  Failure failure_;
+};
+
+}  // namespace synth
+
+#endif  // _synth_loop_scheduler_h_
@@ -0,0 +1,135 @@
+#include "synth/loop_scheduler.h"
+
+#include <memory>
+
+#include "iroha/iroha.h"
+#include "iroha/test_util.h"
+#include "synth/method_context.h"
+
+namespace synth {
+
+// Body of a loop. Each state has an insn on its own resource or a shared
+// one.
+class SchedulerTestLoop {
+ public:
+  SchedulerTestLoop() : design_(new IDesign), context_(nullptr) {
+    IModule *mod = new IModule(design_.get(), "mod");
+    design_->modules_.push_back(mod);
+    tab_ = new ITable(mod);
+    mod->tables_.push_back(tab_);
+  }
+
+  IState *AddState() {
+    IState *st = new IState(tab_);
+    tab_->states_.push_back(st);
+    if (context_.states_.size() > 0) {
+      DesignTool::AddNextState(context_.LastState()->state_, st);
+    }
+    StateWrapper *sw = new StateWrapper();
+    sw->state_ = st;
+    sw->index_ = context_.states_.size();
+    context_.states_.push_back(sw);
+    return st;
+  }
+
+  IRegister *Reg(const string &name) {
+    IRegister *reg = new IRegister(tab_, name);
+    reg->value_type_.SetWidth(32);
+    tab_->registers_.push_back(reg);
+    return reg;
+  }
+
+  IResource *Adder() {
+    IResourceClass *rc =
+        DesignUtil::FindResourceClass(design_.get(), resource::kAdd);
+    IResource *res = new IResource(tab_, rc);
+    tab_->resources_.push_back(res);
+    return res;
+  }
+
+  // Emits dst = lhs + rhs on res.
+  void Add(IState *st, IResource *res, IRegister *lhs, IRegister *rhs,
+           IRegister *dst) {
+    IInsn *insn = new IInsn(res);
+    insn->inputs_.push_back(lhs);
+    insn->inputs_.push_back(rhs);
+    insn->outputs_.push_back(dst);
+    st->insns_.push_back(insn);
+  }
+
+  LoopScheduler *Scheduler() {
+    scheduler_.reset(new LoopScheduler(&context_, 0, context_.states_.size()));
+    return scheduler_.get();
+  }
+
+ private:
+  std::unique_ptr<IDesign> design_;
+  ITable *tab_;
+  MethodContext context_;
+  std::unique_ptr<LoopScheduler> scheduler_;
+};
+
+void TestLoopScheduler() {
+  {
+    // Straight line without recurrences: t = x + y; w = t + z
+    SchedulerTestLoop l;
+    IRegister *x = l.Reg("x");
+    IRegister *y = l.Reg("y");
+    IRegister *z = l.Reg("z");
+    IRegister *t = l.Reg("t");
+    IRegister *w = l.Reg("w");
+    l.Add(l.AddState(), l.Adder(), x, y, t);
+    l.Add(l.AddState(), l.Adder(), t, z, w);
+    LoopScheduler *s = l.Scheduler();
+    ASSERT(s->Schedule() == 1);
+    ASSERT(s->GetFailure() == LoopScheduler::NONE);
+    ASSERT(s->GetResMII() == 1);
+    ASSERT(s->GetRecMII() == 1);
+  }
+  {
+    // Same as above on one adder.
+    SchedulerTestLoop l;
+    IRegister *x = l.Reg("x");
+    IRegister *y = l.Reg("y");
+    IRegister *z = l.Reg("z");
+    IRegister *t = l.Reg("t");
+    IRegister *w = l.Reg("w");
+    IResource *adder = l.Adder();
+    l.Add(l.AddState(), adder, x, y, t);
+    l.Add(l.AddState(), adder, t, z, w);
+    LoopScheduler *s = l.Scheduler();
+    ASSERT(s->Schedule() == 2);
+    ASSERT(s->GetResMII() == 2);
+  }
+  {
+    // Recurrence over 2 states: t = s + a; s = t + b
+    SchedulerTestLoop l;
+    IRegister *a = l.Reg("a");
+    IRegister *b = l.Reg("b");
+    IRegister *s = l.Reg("s");
+    IRegister *t = l.Reg("t");
+    l.Add(l.AddState(), l.Adder(), s, a, t);
+    l.Add(l.AddState(), l.Adder(), t, b, s);
+    LoopScheduler *sched = l.Scheduler();
+    ASSERT(sched->Schedule() == 2);
+    ASSERT(sched->GetRecMII() == 2);
+  }
+  {
+    // A branch to a state in the body is rejected.
+    SchedulerTestLoop l;
+    IRegister *a = l.Reg("a");
+    IRegister *t = l.Reg("t");
+    IState *st0 = l.AddState();
+    l.Add(st0, l.Adder(), a, a, t);
+    IState *st1 = l.AddState();
+    l.Add(st1, l.Adder(), t, a, t);
+    IState *st2 = l.AddState();
+    l.Add(st2, l.Adder(), t, t, a);
+    DesignTool::AddNextState(st0, st2);
+    LoopScheduler *s = l.Scheduler();
+    ASSERT(s->Schedule() == -1);
+    ASSERT(s->GetFailure() == LoopScheduler::HAS_BRANCH);
+  }
+}
+
+}  // namespace synth
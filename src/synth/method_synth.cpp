@@ -1,5 +1,7 @@
 #include "synth/method_synth.h"
 
+#include <sstream>
+
 #include "base/status.h"
 #include "fe/expr.h"
 #include "fe/method.h"
@@ -7,10 +9,12 @@
 #include "iroha/iroha.h"
 #include "karuta/annotation.h"
 #include "synth/design_synth.h"
+#include "synth/loop_scheduler.h"
 #include "synth/method_context.h"
 #include "synth/object_method.h"
 #include "synth/object_method_names.h"
 #include "synth/object_synth.h"
+#include "synth/resource_binder.h"
 #include "synth/resource_set.h"
 #include "synth/resource_synth.h"
 #include "synth/shared_resource_set.h"
@@ -100,6 +104,10 @@ bool MethodSynth::SynthFromInsns() {
 
   ResolveJumps();
   LinkStates();
+  ResourceBinder binder(context_.get(), res_set_,
+                        method_->GetAnnotation()->GetUnits());
+  binder.Bind();
+  CollectPipelineLoops();
   if (is_task_entry_) {
     EmitTaskEntry(context_->states_[0]->state_);
     EmitTaskReturn(context_->states_[context_->states_.size() - 1]->state_);
@@ -869,6 +877,13 @@ void MethodSynth::SynthArrayAccess(vm::Insn *insn, bool is_write) {
   }
   IRegister *index = GetArrayIndex(array_obj, insn, s);
   if (UseSharedArray(array_obj)) {
+    Annotation *a = vm::ArrayWrapper::GetAnnotation(array_obj);
+    if (a != nullptr && a->GetBanks() > 1) {
+      Status::os(Status::USER_ERROR)
+          << "banks= can't be used for an array shared by threads or "
+          << "accessed from outside: " << method_name_;
+      return;
+    }
     SynthSharedArrayAccess(insn, is_write, index);
   } else {
     SynthLocalArrayAccess(insn, is_write, index);
@@ -950,8 +965,17 @@ void MethodSynth::SynthSharedArrayAccess(vm::Insn *insn, bool is_write,
 void MethodSynth::SynthLocalArrayAccess(vm::Insn *insn, bool is_write,
                                         IRegister *index) {
   vm::Object *array_obj = GetObjByReg(insn->obj_reg_);
-  IResource *res = res_set_->GetInternalArrayResource(array_obj);
-  rsynth_->MayConfigureExternalSram(array_obj, res);
+  IResource *res;
+  Annotation *a = vm::ArrayWrapper::GetAnnotation(array_obj);
+  if (a != nullptr && a->GetBanks() > 1) {
+    res = GetArrayBank(array_obj, insn, is_write, &index);
+    if (res == nullptr) {
+      return;
+    }
+  } else {
+    res = res_set_->GetInternalArrayResource(array_obj);
+    rsynth_->MayConfigureExternalSram(array_obj, res);
+  }
   IInsn *iinsn = new IInsn(res);
   if (!is_write) {
     SynthSramRead(insn, iinsn, index);
@@ -965,6 +989,81 @@ void MethodSynth::SynthLocalArrayAccess(vm::Insn *insn, bool is_write,
   w->state_->insns_.push_back(iinsn);
 }
 
+IResource *MethodSynth::GetArrayBank(vm::Object *array_obj, vm::Insn *insn,
+                                     bool is_write, IRegister **index) {
+  Annotation *a = vm::ArrayWrapper::GetAnnotation(array_obj);
+  vm::IntArray *array = vm::ArrayWrapper::GetIntArray(array_obj);
+  int banks = a->GetBanks();
+  bool is_block = a->IsBlockPartition();
+  uint64_t length = array->GetLength();
+  uint64_t bank_length = (length + banks - 1) / banks;
+  int s = 0;
+  if (is_write) {
+    s = 1;
+  }
+  vm::Register *index_reg = insn->src_regs_[s];
+  int bank = -1;
+  if (array->GetShape().size() == 1) {
+    if (index_reg->type_.is_const_) {
+      uint64_t i = index_reg->initial_num_.GetValue0() % length;
+      if (is_block) {
+        bank = i / bank_length;
+      } else {
+        bank = i % banks;
+      }
+    } else if (insn->src_regs_.size() == s + 2) {
+      // Bank index added by compiler::LoopUnroller.
+      bank = insn->src_regs_[s + 1]->initial_num_.GetValue0();
+    }
+  }
+  if (bank < 0) {
+    Status::os(Status::USER_ERROR)
+        << "Failed to determine the bank of an access to a partitioned array";
+    return nullptr;
+  }
+  if (!is_block && !index_reg->type_.is_const_ &&
+      (banks & (banks - 1)) != 0) {
+    Status::os(Status::USER_ERROR)
+        << "The number of cyclic banks should be a power of 2: " << banks;
+    return nullptr;
+  }
+  IResource *res = res_set_->GetInternalArrayBank(array_obj, bank);
+  int address_bits = res->GetArray()->GetAddressWidth();
+  // Index in the bank.
+  if (index_reg->type_.is_const_) {
+    uint64_t i = index_reg->initial_num_.GetValue0() % length;
+    if (is_block) {
+      i -= bank * bank_length;
+    } else {
+      i /= banks;
+    }
+    *index = DesignTool::AllocConstNum(tab_, address_bits, i);
+    return res;
+  }
+  IValueType vt;
+  vt.SetWidth((*index)->value_type_.GetWidth());
+  IInsn *iinsn;
+  if (is_block) {
+    iinsn = new IInsn(res_set_->GetOpResource(vm::OP_SUB, vt));
+    iinsn->inputs_.push_back(*index);
+    iinsn->inputs_.push_back(DesignTool::AllocConstNum(
+        tab_, (*index)->value_type_.GetWidth(), bank * bank_length));
+  } else {
+    iinsn = new IInsn(res_set_->GetOpResource(vm::OP_RSHIFT, vt));
+    iinsn->inputs_.push_back(*index);
+    iinsn->inputs_.push_back(
+        DesignTool::AllocConstNum(tab_, 32, Util::Log2(banks)));
+    iinsn->SetOperand(iroha::operand::kRight);
+  }
+  IRegister *reg = thr_synth_->AllocRegister("t");
+  reg->value_type_.SetWidth(address_bits);
+  iinsn->outputs_.push_back(reg);
+  StateWrapper *sw = AllocState();
+  sw->state_->insns_.push_back(iinsn);
+  *index = reg;
+  return res;
+}
+
 void MethodSynth::SynthSramRead(vm::Insn *insn, IInsn *iinsn,
                                 IRegister *index) {
   // Output address.
@@ -1113,4 +1212,101 @@ void MethodSynth::MayAnnotateProfile(int pc, StateWrapper *prev_last) {
   }
 }
 
+void MethodSynth::CollectPipelineLoops() {
+  for (size_t i = 0; i < method_->insns_.size(); ++i) {
+    vm::Insn *insn = method_->insns_[i];
+    if (insn->op_ != vm::OP_GOTO || insn->jump_target_ > i) {
+      continue;
+    }
+    vm::Register *loop_reg = FindPipelineLoopRegister(insn->jump_target_, i);
+    if (loop_reg == nullptr) {
+      continue;
+    }
+    int start = vm_insn_state_map_[insn->jump_target_]->index_;
+    int end = context_->states_.size() - 1;
+    if (i + 1 < method_->insns_.size()) {
+      end = vm_insn_state_map_[i + 1]->index_;
+    }
+    PipelineLoop loop;
+    loop.name_ = method_name_ + ":" + sym_str(loop_reg->orig_name_);
+    loop.start_ = start;
+    loop.end_ = end;
+    loop.target_ii_ = loop_reg->GetAnnotation()->GetII();
+    loop.ii_ = -1;
+    loop.res_mii_ = 0;
+    loop.rec_mii_ = 0;
+    loop.max_ii_ = 0;
+    loop.failure_ = LoopScheduler::NONE;
+    pipeline_loops_.push_back(loop);
+  }
+}
+
+void MethodSynth::ScheduleLoops() {
+  for (PipelineLoop &loop : pipeline_loops_) {
+    LoopScheduler scheduler(context_.get(), loop.start_, loop.end_);
+    loop.ii_ = scheduler.Schedule();
+    loop.res_mii_ = scheduler.GetResMII();
+    loop.rec_mii_ = scheduler.GetRecMII();
+    loop.max_ii_ = scheduler.GetMaxII();
+    loop.failure_ = scheduler.GetFailure();
+  }
+}
+
+void MethodSynth::ReportLoops() {
+  DesignSynth *ds = thr_synth_->GetObjectSynth()->GetDesignSynth();
+  for (PipelineLoop &loop : pipeline_loops_) {
+    std::ostringstream os;
+    if (loop.failure_ != LoopScheduler::NONE) {
+      os << "Can't schedule the loop of " << loop.name_;
+      if (loop.failure_ == LoopScheduler::HAS_BRANCH) {
+        os << ", since it has branches in the body.";
+      } else {
+        os << ", since no II up to " << loop.max_ii_
+           << " satisfies the dependencies (ResMII=" << loop.res_mii_
+           << ", RecMII=" << loop.rec_mii_ << ").";
+      }
+      ds->Report(os.str());
+      if (loop.target_ii_ > 0) {
+        ReportTargetII(loop);
+      }
+      continue;
+    }
+    os << "Lower bound of the II of the loop of " << loop.name_ << ": "
+       << loop.ii_ << " (ResMII=" << loop.res_mii_
+       << ", RecMII=" << loop.rec_mii_ << ")";
+    ds->Report(os.str());
+    if (loop.target_ii_ > 0 && loop.ii_ > loop.target_ii_) {
+      ReportTargetII(loop);
+    }
+  }
+}
+
+void MethodSynth::ReportTargetII(const PipelineLoop &loop) {
+  // Only a warning, since the II is a lower bound and the pipelined states
+  // are built by Iroha.
+  std::ostringstream os;
+  os << "Warning: ii=" << loop.target_ii_ << " may not be achieved for the "
+     << "loop of " << loop.name_;
+  thr_synth_->GetObjectSynth()->GetDesignSynth()->Report(os.str());
+}
+
+vm::Register *MethodSynth::FindPipelineLoopRegister(int start, int end) {
+  for (int i = start; i <= end; ++i) {
+    vm::Insn *insn = method_->insns_[i];
+    for (vm::Register *reg : insn->dst_regs_) {
+      Annotation *an = reg->GetAnnotation();
+      if (an != nullptr && an->IsPipeline()) {
+        return reg;
+      }
+    }
+    for (vm::Register *reg : insn->src_regs_) {
+      Annotation *an = reg->GetAnnotation();
+      if (an != nullptr && an->IsPipeline()) {
+        return reg;
+      }
+    }
+  }
+  return nullptr;
+}
+
 }  // namespace synth
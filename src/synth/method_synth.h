@@ -6,6 +6,7 @@
 #include <tuple>
 
 #include "synth/insn_walker.h"
+#include "synth/loop_scheduler.h"
 
 using std::map;
 using std::tuple;
@@ -26,6 +27,13 @@ class MethodSynth : public InsnWalker {
   bool IsDataFlowEntry() const;
   bool IsExtEntry() const;
   bool IsThreadEntry() const;
+  // Estimates a lower bound of the initiation interval of each loop with
+  // @Pipeline() found by Synth(). Called after the table calls of all the objects are
+  // resolved.
+  void ScheduleLoops();
+  // Reports the results of ScheduleLoops(). They are advisory, since the
+  // pipelined states are built by Iroha.
+  void ReportLoops();
 
   // for ObjectMethod
   ResourceSet *GetResourceSet();
@@ -66,6 +74,8 @@ class MethodSynth : public InsnWalker {
   bool UseSharedArray(vm::Object *array_obj);
   void SynthSharedArrayAccess(vm::Insn *insn, bool is_write, IRegister *index);
   void SynthLocalArrayAccess(vm::Insn *insn, bool is_write, IRegister *index);
+  IResource *GetArrayBank(vm::Object *array_obj, vm::Insn *insn, bool is_write,
+                          IRegister **index);
   void SynthSramRead(vm::Insn *insn, IInsn *iinsn, IRegister *index);
   void SynthBitRange(vm::Insn *insn);
   void SynthConcat(vm::Insn *insn);
@@ -88,6 +98,25 @@ class MethodSynth : public InsnWalker {
   // TODO: Fix this in compiler side.
   void AdjustArgWidth(vm::Insn *insn, vector<IRegister *> *args);
   void MayAnnotateProfile(int pc, StateWrapper *prev_last);
+  void CollectPipelineLoops();
+  vm::Register *FindPipelineLoopRegister(int start, int end);
+
+  class PipelineLoop {
+   public:
+    string name_;
+    // States of the body.
+    int start_;
+    int end_;
+    // From the annotation. 0 if not specified.
+    int target_ii_;
+    // Set by ScheduleLoops().
+    int ii_;
+    int res_mii_;
+    int rec_mii_;
+    int max_ii_;
+    LoopScheduler::Failure failure_;
+  };
+  void ReportTargetII(const PipelineLoop &loop);
 
   ThreadSynth *thr_synth_;
   const string method_name_;
@@ -105,6 +134,7 @@ class MethodSynth : public InsnWalker {
   map<tuple<vm::Object *, string>, IRegister *> member_name_reg_map_;
 
   map<int, StateWrapper *> vm_insn_state_map_;
+  vector<PipelineLoop> pipeline_loops_;
 
   IRegister *FindArgRegister(vm::Method *method, int nth,
                              fe::VarDecl *arg_decl);
@@ -3,6 +3,7 @@
 #include "base/status.h"
 #include "iroha/iroha.h"
 #include "karuta/annotation.h"
+#include "synth/design_synth.h"
 #include "synth/insn_walker.h"
 #include "synth/method_context.h"
 #include "synth/method_synth.h"
@@ -224,7 +225,9 @@ IInsn *ObjectMethod::SynthChannelAccess(vm::Object *ch_obj, bool is_write) {
   ResourceSet *rset = synth_->GetResourceSet();
   SharedResource *sres =
       synth_->GetSharedResourceSet()->GetByObj(ch_obj, nullptr);
-  int depth = vm::ChannelWrapper::ChannelDepth(ch_obj);
+  DesignSynth *design_synth =
+      synth_->GetThreadSynth()->GetObjectSynth()->GetDesignSynth();
+  int depth = design_synth->GetChannelDepth(ch_obj);
   if (sres->GetOwnerThread() == synth_->GetThreadSynth()) {
     IResource *channel_res =
         rset->GetChannelResource(ch_obj, true, false, width, depth);
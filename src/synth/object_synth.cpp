@@ -141,8 +141,8 @@ void ObjectSynth::ResolveTableCall(const TableCall &call) {
   }
   IInsn *insn = nullptr;
   if (call.is_sub_obj_call) {
-    insn = ThreadSynth::InjectSubModuleCall(call.call_state, call.call_insn,
-                                            callee_table);
+    insn = ThreadSynth::InjectSubModuleCall(call.caller_thread, call.call_state,
+                                            call.call_insn, callee_table);
   } else if (call.is_data_flow_call) {
     bool no_wait = call.callee_method->GetAnnotation()->IsNoWait();
     insn =
@@ -154,7 +154,8 @@ void ObjectSynth::ResolveTableCall(const TableCall &call) {
     if (name.empty()) {
       name = call.callee_func;
     }
-    insn = ThreadSynth::InjectExtStubCall(call.call_state, call.call_insn, name,
+    insn = ThreadSynth::InjectExtStubCall(call.caller_thread, call.call_state,
+                                          call.call_insn, name,
                                           call.is_ext_flow_stub_call);
   }
   if (insn == nullptr) {
@@ -178,6 +179,18 @@ void ObjectSynth::ResolveTableCall(const TableCall &call) {
   }
 }
 
+void ObjectSynth::ScheduleLoops() {
+  for (auto *thr : threads_) {
+    thr->ScheduleLoops();
+  }
+}
+
+void ObjectSynth::ReportLoops() {
+  for (auto *thr : threads_) {
+    thr->ReportLoops();
+  }
+}
+
 ThreadSynth *ObjectSynth::GetThreadByName(const string &name) {
   for (auto *thr : threads_) {
     if (thr->GetEntryMethodName() == name) {
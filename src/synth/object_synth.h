@@ -21,6 +21,9 @@ class ObjectSynth {
   bool Scan(bool *ok);
   bool Synth();
   void ResolveTableCallsAll();
+  // See MethodSynth::ScheduleLoops().
+  void ScheduleLoops();
+  void ReportLoops();
   void DeterminePrimaryThread();
   const string &GetName() const;
 
@@ -0,0 +1,168 @@
+#include "synth/resource_binder.h"
+
+#include "iroha/iroha.h"
+#include "synth/method_context.h"
+#include "synth/resource_set.h"
+
+namespace synth {
+
+// Sequences executed less than 1/kColdRatio of the hottest one are cold.
+static const int kColdRatio = 16;
+
+ResourceBinder::ResourceBinder(MethodContext *context, ResourceSet *res_set,
+                               int units)
+    : context_(context), res_set_(res_set), units_(units) {}
+
+void ResourceBinder::Bind() {
+  if (units_ <= 1) {
+    return;
+  }
+  CountPredecessors();
+  int num_states = context_->states_.size();
+  long max_count = GetMaxCount(0, num_states);
+  for (int start = 0; start < num_states;) {
+    int end = FindSequenceEnd(start);
+    if (max_count == 0 || GetMaxCount(start, end) * kColdRatio >= max_count) {
+      BindSequence(start, end);
+    }
+    start = end;
+  }
+  UpdateDependingInsns();
+}
+
+void ResourceBinder::CountPredecessors() {
+  for (StateWrapper *sw : context_->states_) {
+    IInsn *tr_insn = DesignUtil::FindTransitionInsn(sw->state_);
+    if (tr_insn == nullptr) {
+      continue;
+    }
+    for (IState *st : tr_insn->target_states_) {
+      ++num_preds_[st];
+    }
+  }
+}
+
+int ResourceBinder::FindSequenceEnd(int start) {
+  int num_states = context_->states_.size();
+  int i;
+  for (i = start; i + 1 < num_states; ++i) {
+    IState *next = context_->states_[i + 1]->state_;
+    IState *st = context_->states_[i]->state_;
+    IInsn *tr_insn = DesignUtil::FindTransitionInsn(st);
+    if (tr_insn == nullptr || tr_insn->target_states_.size() != 1 ||
+        tr_insn->target_states_[0] != next || num_preds_[next] != 1) {
+      break;
+    }
+  }
+  return i + 1;
+}
+
+long ResourceBinder::GetMaxCount(int start, int end) {
+  long count = 0;
+  for (int i = start; i < end; ++i) {
+    const IProfile &profile = context_->states_[i]->state_->GetProfile();
+    if (profile.valid_ && profile.raw_count_ > count) {
+      count = profile.raw_count_;
+    }
+  }
+  return count;
+}
+
+void ResourceBinder::BindSequence(int start, int end) {
+  bound_.clear();
+  // 0th instance -> number of uses in this sequence.
+  map<IResource *, int> uses;
+  // Insns which write each register and insns each insn depends on.
+  map<IRegister *, IInsn *> writers;
+  map<IInsn *, set<IInsn *>> deps;
+  for (int i = start; i < end; ++i) {
+    IState *st = context_->states_[i]->state_;
+    for (IInsn *&insn : st->insns_) {
+      set<IInsn *> &d = deps[insn];
+      for (IRegister *reg : insn->inputs_) {
+        auto it = writers.find(reg);
+        if (it != writers.end()) {
+          d.insert(it->second);
+          const set<IInsn *> &wd = deps[it->second];
+          d.insert(wd.begin(), wd.end());
+        }
+      }
+      IResource *res = insn->GetResource();
+      if (res_set_->IsOpResource(res)) {
+        int nth = SelectInstance(res, st, d, uses[res]++);
+        bound_[res][nth].push_back(std::make_pair(insn, st));
+        if (nth > 0) {
+          IInsn *rebound =
+              Rebind(insn, res_set_->GetOpResourceInstance(res, nth));
+          deps[rebound] = d;
+          rebound_[insn] = rebound;
+          insn = rebound;
+        }
+      }
+    }
+    // Registers are updated at the end of the state.
+    for (IInsn *insn : st->insns_) {
+      for (IRegister *reg : insn->outputs_) {
+        writers[reg] = insn;
+      }
+    }
+  }
+}
+
+int ResourceBinder::SelectInstance(IResource *res, IState *st,
+                                   const set<IInsn *> &deps, int num_uses) {
+  auto &instances = bound_[res];
+  instances.resize(units_);
+  // Instances used in this state can't be shared.
+  vector<bool> busy(units_, false);
+  for (int nth = 0; nth < units_; ++nth) {
+    bool may_overlap = false;
+    for (auto &use : instances[nth]) {
+      if (use.second == st) {
+        busy[nth] = true;
+      }
+      if (use.second == st || deps.find(use.first) == deps.end()) {
+        may_overlap = true;
+      }
+    }
+    if (!may_overlap) {
+      return nth;
+    }
+  }
+  // Round robin among the ones not used in this state.
+  for (int i = 0; i < units_; ++i) {
+    int nth = (num_uses + i) % units_;
+    if (!busy[nth]) {
+      return nth;
+    }
+  }
+  return num_uses % units_;
+}
+
+IInsn *ResourceBinder::Rebind(IInsn *insn, IResource *res) {
+  IInsn *rebound = new IInsn(res);
+  rebound->SetOperand(insn->GetOperand());
+  rebound->inputs_ = insn->inputs_;
+  rebound->outputs_ = insn->outputs_;
+  rebound->target_states_ = insn->target_states_;
+  rebound->depending_insns_ = insn->depending_insns_;
+  return rebound;
+}
+
+void ResourceBinder::UpdateDependingInsns() {
+  if (rebound_.empty()) {
+    return;
+  }
+  for (StateWrapper *sw : context_->states_) {
+    for (IInsn *insn : sw->state_->insns_) {
+      for (IInsn *&dinsn : insn->depending_insns_) {
+        auto it = rebound_.find(dinsn);
+        if (it != rebound_.end()) {
+          dinsn = it->second;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace synth
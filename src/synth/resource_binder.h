@@ -0,0 +1,60 @@
+// -*- C++ -*-
+#ifndef _synth_resource_binder_h_
+#define _synth_resource_binder_h_
+
+#include "synth/common.h"
+
+#include <map>
+#include <set>
+
+using std::map;
+using std::set;
+
+namespace synth {
+
+// Binds op insns (add, mul and so on) of a synthesized method to instances
+// of the op resources.
+//
+// ResourceSet::GetOpResource() returns one instance per op and width in a
+// table. This allocates up to |units| instances of each for the uses in
+// each straight line sequence of states, so that later passes can execute
+// them in parallel. A use gets another instance only if it may overlap
+// with the uses of the instance, i.e. they are in the same state or don't
+// depend on each other. Uses which depend on all the other uses (e.g. a
+// chain of additions) share the 0th instance. Independent uses in different
+// states get different instances too, but they run in parallel only if the
+// states are merged later by the optimizer of Iroha. Sequences which are executed
+// much less frequently than the hottest one according to the profile keep
+// using the shared instance.
+class ResourceBinder {
+ public:
+  ResourceBinder(MethodContext *context, ResourceSet *res_set, int units);
+
+  void Bind();
+
+ private:
+  void CountPredecessors();
+  // Returns the index of the state after the sequence from start.
+  int FindSequenceEnd(int start);
+  long GetMaxCount(int start, int end);
+  void BindSequence(int start, int end);
+  // Returns the index of the instance for the use of res.
+  int SelectInstance(IResource *res, IState *st, const set<IInsn *> &deps,
+                     int num_uses);
+  IInsn *Rebind(IInsn *insn, IResource *res);
+  // Replaces the rebound insns in depending_insns_ of the other insns.
+  void UpdateDependingInsns();
+
+  MethodContext *context_;
+  ResourceSet *res_set_;
+  int units_;
+  map<IState *, int> num_preds_;
+  // Per sequence. Uses of each instance and the states of them.
+  map<IResource *, vector<vector<std::pair<IInsn *, IState *>>>> bound_;
+  // Original insn to the one on another instance.
+  map<IInsn *, IInsn *> rebound_;
+};
+
+}  // namespace synth
+
+#endif  // _synth_resource_binder_h_
@@ -0,0 +1,177 @@
+#include "synth/resource_binder.h"
+
+#include <memory>
+
+#include "iroha/iroha.h"
+#include "iroha/test_util.h"
+#include "synth/method_context.h"
+#include "synth/resource_set.h"
+#include "vm/opcode.h"
+
+namespace synth {
+
+// A straight line sequence of states in a table.
+class BinderTestTable {
+ public:
+  BinderTestTable() : design_(new IDesign), context_(nullptr) {
+    IModule *mod = new IModule(design_.get(), "mod");
+    design_->modules_.push_back(mod);
+    tab_ = new ITable(mod);
+    mod->tables_.push_back(tab_);
+    res_set_.reset(new ResourceSet(tab_));
+    IValueType vt;
+    vt.SetWidth(32);
+    add_ = res_set_->GetOpResource(vm::OP_ADD, vt);
+  }
+
+  IState *AddState() {
+    IState *st = new IState(tab_);
+    tab_->states_.push_back(st);
+    if (context_.states_.size() > 0) {
+      DesignTool::AddNextState(context_.LastState()->state_, st);
+    }
+    StateWrapper *sw = new StateWrapper();
+    sw->state_ = st;
+    sw->index_ = context_.states_.size();
+    context_.states_.push_back(sw);
+    return st;
+  }
+
+  IRegister *Reg(const string &name) {
+    IRegister *reg = new IRegister(tab_, name);
+    reg->value_type_.SetWidth(32);
+    tab_->registers_.push_back(reg);
+    return reg;
+  }
+
+  // Emits dst = lhs + rhs and returns the index of it in the state.
+  int Add(IState *st, IRegister *lhs, IRegister *rhs, IRegister *dst) {
+    IInsn *insn = new IInsn(add_);
+    insn->inputs_.push_back(lhs);
+    insn->inputs_.push_back(rhs);
+    insn->outputs_.push_back(dst);
+    st->insns_.push_back(insn);
+    return st->insns_.size() - 1;
+  }
+
+  void Bind(int units) {
+    ResourceBinder binder(&context_, res_set_.get(), units);
+    binder.Bind();
+  }
+
+  // Index of the instance of the add resource the insn uses. -1 for others.
+  int GetInstance(IState *st, int idx) {
+    IResource *res = st->insns_[idx]->GetResource();
+    for (int nth = 0; nth < NumInstances(); ++nth) {
+      if (res_set_->GetOpResourceInstance(add_, nth) == res) {
+        return nth;
+      }
+    }
+    return -1;
+  }
+
+  int NumInstances() {
+    int n = 0;
+    for (IResource *res : tab_->resources_) {
+      if (res->GetClass() == add_->GetClass()) {
+        ++n;
+      }
+    }
+    return n;
+  }
+
+ private:
+  std::unique_ptr<IDesign> design_;
+  ITable *tab_;
+  MethodContext context_;
+  std::unique_ptr<ResourceSet> res_set_;
+  IResource *add_;
+};
+
+void TestResourceBinder() {
+  {
+    // x = a + b; y = c + d; z = x + y; w = z + a; (p = a + b, q = c + d)
+    BinderTestTable t;
+    IRegister *a = t.Reg("a");
+    IRegister *b = t.Reg("b");
+    IRegister *c = t.Reg("c");
+    IRegister *d = t.Reg("d");
+    IRegister *x = t.Reg("x");
+    IRegister *y = t.Reg("y");
+    IRegister *z = t.Reg("z");
+    IRegister *w = t.Reg("w");
+    IRegister *p = t.Reg("p");
+    IRegister *q = t.Reg("q");
+    IState *s0 = t.AddState();
+    int x_idx = t.Add(s0, a, b, x);
+    IState *s1 = t.AddState();
+    int y_idx = t.Add(s1, c, d, y);
+    IState *s2 = t.AddState();
+    int z_idx = t.Add(s2, x, y, z);
+    IState *s3 = t.AddState();
+    int w_idx = t.Add(s3, z, a, w);
+    IState *s4 = t.AddState();
+    int p_idx = t.Add(s4, a, b, p);
+    int q_idx = t.Add(s4, c, d, q);
+    t.Bind(2);
+    ASSERT(t.NumInstances() == 2);
+    // y doesn't depend on x.
+    ASSERT(t.GetInstance(s0, x_idx) == 0);
+    ASSERT(t.GetInstance(s1, y_idx) == 1);
+    // The chain stays on the 0th instance.
+    ASSERT(t.GetInstance(s2, z_idx) == 0);
+    ASSERT(t.GetInstance(s3, w_idx) == 0);
+    // Same state.
+    ASSERT(t.GetInstance(s4, p_idx) != t.GetInstance(s4, q_idx));
+  }
+  {
+    // A chain doesn't allocate more instances.
+    BinderTestTable t;
+    IRegister *a = t.Reg("a");
+    IRegister *s = t.Reg("s");
+    for (int i = 0; i < 4; ++i) {
+      IState *st = t.AddState();
+      t.Add(st, s, a, s);
+    }
+    t.Bind(4);
+    ASSERT(t.NumInstances() == 1);
+  }
+  {
+    // Up to units instances for the adds in a state.
+    BinderTestTable t;
+    IRegister *a = t.Reg("a");
+    IState *st = t.AddState();
+    for (int i = 0; i < 4; ++i) {
+      t.Add(st, a, a, t.Reg("r" + std::to_string(i)));
+    }
+    t.Bind(3);
+    ASSERT(t.NumInstances() == 3);
+    ASSERT(t.GetInstance(st, 0) == 0);
+    ASSERT(t.GetInstance(st, 1) == 1);
+    ASSERT(t.GetInstance(st, 2) == 2);
+    // Without units=, all of them use the shared instance.
+    BinderTestTable u;
+    IRegister *b = u.Reg("b");
+    IState *ust = u.AddState();
+    u.Add(ust, b, b, u.Reg("r0"));
+    u.Add(ust, b, b, u.Reg("r1"));
+    u.Bind(1);
+    ASSERT(u.NumInstances() == 1);
+  }
+  {
+    // An insn depending on a rebound insn refers to the new one.
+    BinderTestTable t;
+    IRegister *a = t.Reg("a");
+    IState *st = t.AddState();
+    t.Add(st, a, a, t.Reg("r0"));
+    int idx = t.Add(st, a, a, t.Reg("r1"));
+    IState *next = t.AddState();
+    int dep_idx = t.Add(next, a, a, t.Reg("r2"));
+    next->insns_[dep_idx]->depending_insns_.push_back(st->insns_[idx]);
+    t.Bind(2);
+    ASSERT(t.GetInstance(st, idx) == 1);
+    ASSERT(next->insns_[dep_idx]->depending_insns_[0] == st->insns_[idx]);
+  }
+}
+
+}  // namespace synth
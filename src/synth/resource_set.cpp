@@ -30,6 +30,7 @@ ResourceSet::ResourceSet(ITable *tab) : tab_(tab) {
   task_return_reg_writer_ = nullptr;
   ext_task_ = nullptr;
   ext_task_done_ = nullptr;
+  num_indexed_ = 0;
 }
 
 ResourceSet::~ResourceSet() {}
@@ -402,6 +403,30 @@ IResource *ResourceSet::GetInternalArrayResource(vm::Object *obj) {
     return it->second;
   }
   vm::IntArray *memory = vm::ArrayWrapper::GetIntArray(obj);
+  IResource *res = CreateArrayResource(memory);
+  array_resources_[obj] = res;
+  return res;
+}
+
+IResource *ResourceSet::GetInternalArrayBank(vm::Object *obj, int nth) {
+  CHECK(vm::ArrayWrapper::IsIntArray(obj));
+  map<int, IResource *> &banks = array_banks_[obj];
+  auto it = banks.find(nth);
+  if (it != banks.end()) {
+    return it->second;
+  }
+  Annotation *a = vm::ArrayWrapper::GetAnnotation(obj);
+  CHECK(a != nullptr);
+  vm::IntArray *memory = vm::ArrayWrapper::GetIntArray(obj);
+  vm::IntArray *bank = vm::IntArray::CreateBank(
+      memory, a->GetBanks(), a->IsBlockPartition(), nth);
+  IResource *res = CreateArrayResource(bank);
+  delete bank;
+  banks[nth] = res;
+  return res;
+}
+
+IResource *ResourceSet::CreateArrayResource(vm::IntArray *memory) {
   int address_bits = memory->GetAddressWidth();
   int data_bits = memory->GetDataWidth().GetWidth();
   IResource *res = DesignTool::CreateArrayResource(tab_, address_bits,
@@ -415,7 +440,6 @@ IResource *ResourceSet::GetInternalArrayResource(vm::Object *obj) {
     }
     res->GetArray()->SetArrayImage(image);
   }
-  array_resources_[obj] = res;
   return res;
 }
 
@@ -439,10 +463,10 @@ IResource *ResourceSet::GetOpResource(vm::OpCode op, IValueType &vt) {
         op == vm::OP_RSHIFT)) {
     key_vt = vt;
   }
-  for (auto &res : resources_) {
-    if (res.op == op && key_vt.GetWidth() == res.vt.GetWidth()) {
-      return res.resource;
-    }
+  auto key = std::make_tuple(op, key_vt.GetWidth());
+  auto it = op_resources_.find(key);
+  if (it != op_resources_.end()) {
+    return it->second;
   }
   string rcn = GetResourceClassName(op);
   IResourceClass *rc =
@@ -450,14 +474,29 @@ IResource *ResourceSet::GetOpResource(vm::OpCode op, IValueType &vt) {
   IResource *ires = new IResource(tab_, rc);
   tab_->resources_.push_back(ires);
   PopulateResourceDataType(op, vt, ires);
-  ResourceEntry res;
-  res.op = op;
-  res.vt = key_vt;
-  res.resource = ires;
-  resources_.push_back(res);
+  op_resources_[key] = ires;
+  op_instances_[ires].push_back(ires);
   return ires;
 }
 
+IResource *ResourceSet::GetOpResourceInstance(IResource *res, int nth) {
+  auto it = op_instances_.find(res);
+  CHECK(it != op_instances_.end());
+  vector<IResource *> &instances = it->second;
+  while (instances.size() <= nth) {
+    IResource *ires = new IResource(tab_, res->GetClass());
+    ires->input_types_ = res->input_types_;
+    ires->output_types_ = res->output_types_;
+    tab_->resources_.push_back(ires);
+    instances.push_back(ires);
+  }
+  return instances[nth];
+}
+
+bool ResourceSet::IsOpResource(IResource *res) {
+  return op_instances_.find(res) != op_instances_.end();
+}
+
 string ResourceSet::GetResourceClassName(vm::OpCode op) {
   switch (op) {
     case vm::OP_GT:
@@ -576,4 +615,68 @@ IResource *ResourceSet::GetDataFlowInResource() {
   return dataflow_in_;
 }
 
+ITable *ResourceSet::GetTable() const { return tab_; }
+
+IResource *ResourceSet::FindTaskCallResource(ITable *callee) {
+  UpdateIndexes();
+  auto it = task_calls_.find(callee);
+  if (it == task_calls_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+IResource *ResourceSet::FindChildResource(IResource *parent) {
+  UpdateIndexes();
+  auto it = child_resources_.find(parent);
+  if (it == child_resources_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+IResource *ResourceSet::FindExtStubResource(const string &name, bool is_flow,
+                                            bool is_wait) {
+  UpdateIndexes();
+  map<string, IResource *> *m;
+  if (is_wait) {
+    m = is_flow ? &ext_flow_results_ : &ext_task_waits_;
+  } else {
+    m = is_flow ? &ext_flow_calls_ : &ext_task_calls_;
+  }
+  auto it = m->find(name);
+  if (it == m->end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+void ResourceSet::UpdateIndexes() {
+  // Resources are only appended during the synthesis and the first one
+  // for each key is kept as the linear scan used to find.
+  for (; num_indexed_ < tab_->resources_.size(); ++num_indexed_) {
+    IResource *res = tab_->resources_[num_indexed_];
+    const IResourceClass &rc = *res->GetClass();
+    IResource *parent = res->GetParentResource();
+    if (parent != nullptr) {
+      child_resources_.insert(std::make_pair(parent, res));
+    }
+    if (resource::IsTaskCall(rc)) {
+      task_calls_.insert(std::make_pair(res->GetCalleeTable(), res));
+    } else if (resource::IsExtTaskCall(rc)) {
+      ext_task_calls_.insert(
+          std::make_pair(res->GetParams()->GetExtTaskName(), res));
+    } else if (resource::IsExtFlowCall(rc)) {
+      ext_flow_calls_.insert(
+          std::make_pair(res->GetParams()->GetExtTaskName(), res));
+    } else if (resource::IsExtTaskWait(rc) && parent != nullptr) {
+      ext_task_waits_.insert(
+          std::make_pair(parent->GetParams()->GetExtTaskName(), res));
+    } else if (resource::IsExtFlowResult(rc) && parent != nullptr) {
+      ext_flow_results_.insert(
+          std::make_pair(parent->GetParams()->GetExtTaskName(), res));
+    }
+  }
+}
+
 }  // namespace synth
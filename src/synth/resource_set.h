@@ -9,11 +9,13 @@
 
 // for IValueType
 #include <map>
+#include <tuple>
 
 #include "iroha/i_design.h"
 #include "vm/opcode.h"
 
 using std::map;
+using std::tuple;
 
 namespace synth {
 
@@ -28,10 +30,16 @@ class ResourceSet {
   IResource *PseudoCallResource();
   IResource *PrintResource();
   IResource *GetOpResource(vm::OpCode op, IValueType &vt);
+  // Returns nth instance of an op resource returned by GetOpResource().
+  // 0th instance is the resource itself.
+  IResource *GetOpResourceInstance(IResource *res, int nth);
+  bool IsOpResource(IResource *res);
 
   IResource *GetImportedResource(vm::Method *method);
   IResource *GetExternalArrayResource(vm::Object *obj);
   IResource *GetInternalArrayResource(vm::Object *obj);
+  // nth bank of an array with @(banks=N).
+  IResource *GetInternalArrayBank(vm::Object *obj, int nth);
   IResource *GetChannelResource(vm::Object *ch, bool is_owner, bool is_write,
                                 int data_width, int depth);
   IResource *GetSubModuleTaskResource();
@@ -52,14 +60,24 @@ class ResourceSet {
   IResource *GetExtTaskDoneResource();
   IResource *GetTicker(vm::Object *obj, bool is_owner);
 
+  ITable *GetTable() const;
+  // Finds resources in the table including ones created outside of this
+  // object (e.g. by DesignTool).
+  IResource *FindTaskCallResource(ITable *callee);
+  IResource *FindChildResource(IResource *parent);
+  IResource *FindExtStubResource(const string &name, bool is_flow,
+                                 bool is_wait);
+
  private:
   string GetResourceClassName(vm::OpCode op);
   void PopulateResourceDataType(int op, IValueType &vt, IResource *res);
   void PopulateIOTypes(fe::VarDeclSet *vds, bool is_output, IResource *res);
+  IResource *CreateArrayResource(vm::IntArray *memory);
   IResource *GetRAMPortResource(vm::Object *obj, const string &name,
                                 map<vm::Object *, IResource *> *resources);
   IResource *BuildExtIO(const string &name, bool is_output, int width,
                         int distance);
+  void UpdateIndexes();
 
   ITable *tab_;
   IResource *assert_;
@@ -74,16 +92,24 @@ class ResourceSet {
   IResource *ext_task_;
   IResource *ext_task_done_;
 
-  class ResourceEntry {
-   public:
-    vm::OpCode op;
-    IValueType vt;
-    IResource *resource;
-  };
-  vector<ResourceEntry> resources_;
+  // op, width.
+  map<tuple<vm::OpCode, int>, IResource *> op_resources_;
+  // 0th instance -> instances.
+  map<IResource *, vector<IResource *> > op_instances_;
+  // Indexes of tab_->resources_ which are updated up to num_indexed_
+  // resources before each lookup, so that the lookups don't scan all of
+  // the resources.
+  size_t num_indexed_;
+  map<ITable *, IResource *> task_calls_;
+  map<IResource *, IResource *> child_resources_;
+  map<string, IResource *> ext_task_calls_;
+  map<string, IResource *> ext_flow_calls_;
+  map<string, IResource *> ext_task_waits_;
+  map<string, IResource *> ext_flow_results_;
 
   vector<IResource *> imported_resources_;
   map<vm::Object *, IResource *> array_resources_;
+  map<vm::Object *, map<int, IResource *> > array_banks_;
   map<vm::Object *, IResource *> ext_sram_if_;
   map<vm::Object *, IResource *> fifo_resources_;
   map<vm::Object *, IResource *> fifo_writers_;
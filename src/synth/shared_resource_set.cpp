@@ -7,6 +7,7 @@
 #include "synth/object_method_names.h"
 #include "synth/object_synth.h"
 #include "synth/thread_synth.h"
+#include "vm/channel_wrapper.h"
 #include "vm/insn.h"
 
 namespace synth {
@@ -161,6 +162,12 @@ void SharedResourceSet::AddObjectAccessor(ThreadSynth *thr,
     }
     if (synth_name == kMailboxGet || synth_name == kMailboxPut) {
     }
+    if (synth_name == kChannelRead) {
+      res->readers_.insert(thr);
+    }
+    if (synth_name == kChannelWrite || synth_name == kChannelNoWaitWrite) {
+      res->writers_.insert(thr);
+    }
   }
 }
 
@@ -207,6 +214,15 @@ bool SharedResourceSet::HasAccessor(vm::Object *obj, ThreadSynth *thr) {
   return (obj_resources_.find(key) != obj_resources_.end());
 }
 
+void SharedResourceSet::GetChannels(vector<vm::Object *> *channels) {
+  for (auto it : obj_resources_) {
+    vm::Object *obj = std::get<0>(it.first);
+    if (vm::ChannelWrapper::IsChannel(obj)) {
+      channels->push_back(obj);
+    }
+  }
+}
+
 bool SharedResourceSet::HasExtIOAccessor(vm::Method *method) {
   auto it = ext_io_methods_.find(method);
   if (it == ext_io_methods_.end()) {
@@ -73,6 +73,8 @@ class SharedResourceSet {
   SharedResource *GetBySlotName(vm::Object *obj, ThreadSynth *thr, sym_t name);
   SharedResource *GetByObj(vm::Object *obj, ThreadSynth *thr);
   bool HasAccessor(vm::Object *obj, ThreadSynth *thr);
+  // Channels accessed by any thread. Order depends on the addresses.
+  void GetChannels(vector<vm::Object *> *channels);
   bool HasExtIOAccessor(vm::Method *method);
 
  private:
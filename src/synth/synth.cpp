@@ -11,10 +11,13 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include "base/status.h"
 #include "base/util.h"
 #include "iroha/iroha.h"
+#include "synth/design_holder.h"
 #include "synth/design_synth.h"
 #include "synth/object_attr_names.h"
+#include "synth/synth_cache.h"
 #include "vm/object.h"
 #include "vm/object_util.h"
 #include "vm/string_wrapper.h"
@@ -22,17 +25,71 @@
 namespace synth {
 
 bool Synth::Synthesize(vm::VM *vm, vm::Object *obj, const string &ofn) {
+  std::unique_ptr<IDesign> design(BuildDesign(vm, obj));
+  if (design.get() == nullptr) {
+    return false;
+  }
+  WriteIr(design.get(), ofn);
+  return true;
+}
+
+bool Synth::Compile(vm::VM *vm, vm::Object *obj) {
+  DesignHolder::ClearDesign(obj);
+  IDesign *design = BuildDesign(vm, obj);
+  if (design == nullptr) {
+    return false;
+  }
+  if (UseExternalIroha(obj) || !DesignHolder::SetDesign(obj, design)) {
+    WriteIr(design, IrPath(obj));
+    delete design;
+    return true;
+  }
+  if (!vm::ObjectUtil::GetStringMember(obj, kIrFileName).empty()) {
+    // Specified by setIROutput().
+    WriteIr(design, IrPath(obj));
+  }
+  return true;
+}
+
+IDesign *Synth::BuildDesign(vm::VM *vm, vm::Object *obj) {
+  string key;
+  vector<string> reports;
+  IDesign *design = SynthCache::Load(vm, obj, &key, &reports);
+  if (design != nullptr) {
+    // Same reports as the synthesis which stored the design.
+    for (const string &r : reports) {
+      Status::os(Status::INFO) << r;
+      MessageFlush::Get(Status::INFO);
+    }
+    return design;
+  }
   DesignSynth design_synth(vm, obj);
   LOG(INFO) << "Synthesize start";
   if (!design_synth.Synth()) {
-    return false;
+    return nullptr;
   }
   LOG(INFO) << "Synthesize done";
+  design = design_synth.ReleaseIDesign();
+  SynthCache::Store(key, design, design_synth.GetReports());
+  return design;
+}
 
-  WriterAPI *writer = Iroha::CreateWriter(design_synth.GetIDesign());
+void Synth::WriteIr(IDesign *design, const string &fn) {
+  WriterAPI *writer = Iroha::CreateWriter(design);
   writer->SetLanguage("");
-  writer->Write(ofn);
-  return true;
+  writer->Write(fn);
+}
+
+void Synth::FlushDesign(vm::Object *obj) {
+  IDesign *design = DesignHolder::GetDesign(obj);
+  if (design != nullptr) {
+    WriteIr(design, IrPath(obj));
+  }
+}
+
+bool Synth::UseExternalIroha(vm::Object *obj) {
+  return (!vm::ObjectUtil::GetStringMember(obj, kIrohaPath).empty() ||
+          !Env::GetIrohaBinPath().empty());
 }
 
 string Synth::IrPath(vm::Object *obj) {
@@ -65,6 +122,10 @@ int Synth::RunIroha(vm::Object *obj, const string &args) {
   if (cmd.empty()) {
     return -1;
   }
+  FlushDesign(obj);
+  // The external iroha may rewrite the IR file (e.g. -opt), so the file
+  // is the design from here.
+  DesignHolder::ClearDesign(obj);
   string path = IrPath(obj);
   string iopt = "--iroha";
   auto dirs = Env::SearchDirList();
@@ -98,6 +159,25 @@ void Synth::WriteHdl(const string &fn, vm::Object *obj) {
   }
   string ofn;
   Env::GetOutputPath(fn.c_str(), &ofn);
+  IDesign *design = DesignHolder::GetDesign(obj);
+  if (design != nullptr && !UseExternalIroha(obj) &&
+      (lang == "-v" || lang.empty()) && Env::GetFlavor().empty() &&
+      GetDumpPath(obj).empty()) {
+    WriterAPI *writer = Iroha::CreateWriter(design);
+    if (lang.empty()) {
+      writer->SetLanguage("");
+    } else {
+      writer->SetLanguage("verilog");
+      writer->OutputShellModule(true, Env::GetWithSelfShell(),
+                                Env::GetVcdOutput());
+    }
+    writer->Write(ofn);
+    const string &marker = Env::GetOutputMarker();
+    if (!marker.empty()) {
+      cout << marker << fn << "\n";
+    }
+    return;
+  }
   string arg = lang;
   if (Env::GetWithSelfShell()) {
     arg += " -S";
@@ -118,6 +198,27 @@ void Synth::WriteHdl(const string &fn, vm::Object *obj) {
 
 int Synth::RunIrohaOpt(const string &pass, vm::Object *obj) {
   LOG(DEBUG) << "pass: " << pass;
+  OptAPI *optimizer = DesignHolder::GetOptimizer(obj);
+  if (optimizer != nullptr && !UseExternalIroha(obj)) {
+    // Applies the passes back to back without the IR file.
+    size_t pos = 0;
+    while (pos <= pass.size()) {
+      size_t next = pass.find(',', pos);
+      if (next == string::npos) {
+        next = pass.size();
+      }
+      string p = pass.substr(pos, next - pos);
+      if (!p.empty() && !optimizer->ApplyPass(p)) {
+        LOG(INFO) << "Failed to apply pass: " << p;
+        return 1;
+      }
+      pos = next + 1;
+    }
+    if (!vm::ObjectUtil::GetStringMember(obj, kIrFileName).empty()) {
+      FlushDesign(obj);
+    }
+    return 0;
+  }
   string tmp = IrPath(obj) + "~";
   string arg = "-opt " + pass + " -o " + tmp;
   int res = RunIroha(obj, arg);
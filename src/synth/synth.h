@@ -4,6 +4,10 @@
 
 #include "karuta/karuta.h"
 
+namespace iroha {
+class IDesign;
+}  // namespace iroha
+
 namespace vm {
 class Object;
 class VM;
@@ -11,16 +15,28 @@ class VM;
 
 namespace synth {
 
+// The IDesign built by Compile() is kept in the object and following
+// RunIrohaOpt() and WriteHdl() work on it in process. The external iroha
+// binary (on the IR file) is used only when it is explicitly specified
+// by setIrohaPath() or --iroha_binary.
 class Synth {
  public:
   static bool Synthesize(vm::VM *vm, vm::Object *obj, const string &ofn);
+  static bool Compile(vm::VM *vm, vm::Object *obj);
   static void WriteHdl(const string &fn, vm::Object *obj);
   static int RunIroha(vm::Object *obj, const string &args);
+  // pass can be comma separated list of passes.
   static int RunIrohaOpt(const string &pass, vm::Object *obj);
   static string IrPath(vm::Object *obj);
   static string GetIrohaCommand(vm::Object *obj);
 
  private:
+  static iroha::IDesign *BuildDesign(vm::VM *vm, vm::Object *obj);
+  static void WriteIr(iroha::IDesign *design, const string &fn);
+  // Writes the design in memory (if any) to IrPath() for the external
+  // binary.
+  static void FlushDesign(vm::Object *obj);
+  static bool UseExternalIroha(vm::Object *obj);
   static string GetDumpPath(vm::Object *obj);
 };
 
@@ -0,0 +1,271 @@
+#include "synth/synth_cache.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "base/dump_stream.h"
+#include "base/util.h"
+#include "fe/method.h"
+#include "iroha/i_design.h"
+#include "iroha/iroha.h"
+#include "karuta/annotation.h"
+#include "vm/array_wrapper.h"
+#include "vm/channel_wrapper.h"
+#include "vm/int_array.h"
+#include "vm/mailbox_wrapper.h"
+#include "vm/method.h"
+#include "vm/object.h"
+#include "vm/profile.h"
+#include "vm/string_wrapper.h"
+#include "vm/value.h"
+#include "vm/vm.h"
+
+namespace synth {
+
+int SynthCache::num_hits_;
+int SynthCache::num_misses_;
+
+namespace {
+
+// Bump this when the synthesizer changes the output for same input.
+const char kCacheFormat[] = "karuta-synth-cache-3";
+
+// Computes a key of everything the synthesizer reads from the object tree.
+//
+// Each object and method gets its own key, and members refer to other
+// objects and methods by their keys instead of their contents. So a method
+// shared by cloned objects is serialized once, and a change is confined to
+// the keys of the objects on the path from the changed one. Objects reached
+// again while their own key is being computed (cycles) are identified by
+// the visiting order instead of addresses, so keys are same across runs.
+class KeyWriter {
+ public:
+  KeyWriter() : num_visited_(0) {}
+
+  string GetObjectKey(vm::Object *obj) {
+    if (obj == nullptr) {
+      return "null";
+    }
+    auto kt = object_keys_.find(obj);
+    if (kt != object_keys_.end()) {
+      return kt->second;
+    }
+    auto it = visiting_.find(obj);
+    if (it != visiting_.end()) {
+      return "ref " + std::to_string(it->second);
+    }
+    int index = num_visited_++;
+    visiting_[obj] = index;
+    std::ostringstream os;
+    const char *type_key = obj->ObjectTypeKey();
+    os << "object " << index << " " << (type_key ? type_key : "") << "\n";
+    if (vm::StringWrapper::IsString(obj)) {
+      os << "string " << vm::StringWrapper::String(obj) << "\n";
+    }
+    if (vm::ArrayWrapper::IsIntArray(obj)) {
+      WriteIntArray(obj, os);
+    } else if (vm::ArrayWrapper::IsObjectArray(obj)) {
+      os << vm::ArrayWrapper::ToString(obj) << "\n";
+      // Elements are read by the synthesizer when they are accessed with
+      // constant indexes.
+      int size = vm::ArrayWrapper::GetObjectArraySize(obj);
+      for (int i = 0; i < size; ++i) {
+        os << GetObjectKey(vm::ArrayWrapper::Get(obj, i)) << "\n";
+      }
+    }
+    if (vm::ChannelWrapper::IsChannel(obj)) {
+      os << "channel #" << vm::ChannelWrapper::ChannelWidth(obj) << " depth="
+         << vm::ChannelWrapper::ChannelDepth(obj) << " ";
+      WriteAnnotation(vm::ChannelWrapper::ChannelAnnotation(obj), os);
+    }
+    if (vm::MailboxWrapper::IsMailbox(obj)) {
+      os << "mailbox #" << vm::MailboxWrapper::GetWidth(obj) << " ";
+      WriteAnnotation(vm::MailboxWrapper::GetAnnotation(obj), os);
+    }
+    for (const std::pair<sym_t, vm::Value> &it : obj->members_) {
+      os << sym_cstr(it.first) << ":";
+      WriteValue(it.second, os);
+    }
+    visiting_.erase(obj);
+    string key = ::Util::HashString(os.str());
+    object_keys_[obj] = key;
+    return key;
+  }
+
+ private:
+  void WriteValue(const vm::Value &value, std::ostream &os) {
+    os << vm::Value::TypeName(value.type_) << " ";
+    switch (value.type_) {
+      case vm::Value::METHOD:
+        os << GetMethodKey(value.method_) << "\n";
+        break;
+      case vm::Value::OBJECT:
+      case vm::Value::INT_ARRAY:
+      case vm::Value::OBJECT_ARRAY:
+        os << GetObjectKey(value.object_) << "\n";
+        break;
+      default:
+        value.Dump(os);
+        os << " #" << value.num_width_.Format() << "\n";
+        break;
+    }
+  }
+
+  string GetMethodKey(vm::Method *method) {
+    if (method == nullptr) {
+      return "null";
+    }
+    auto it = method_keys_.find(method);
+    if (it != method_keys_.end()) {
+      return it->second;
+    }
+    std::ostringstream os;
+    os << method->GetSynthName() << " ";
+    method->GetAnnotation()->Dump(os);
+    os << "\n";
+    const fe::Method *parse_tree = method->GetParseTree();
+    if (parse_tree == nullptr) {
+      os << "native\n";
+    } else {
+      DumpStream ds(os);
+      parse_tree->Dump(ds);
+      method->Dump(ds);
+    }
+    string key = ::Util::HashString(os.str());
+    method_keys_[method] = key;
+    return key;
+  }
+
+  void WriteAnnotation(Annotation *an, std::ostream &os) {
+    if (an != nullptr) {
+      an->Dump(os);
+    }
+    os << "\n";
+  }
+
+  void WriteIntArray(vm::Object *obj, std::ostream &os) {
+    os << vm::ArrayWrapper::ToString(obj) << " #"
+       << vm::ArrayWrapper::GetDataWidth(obj) << " ";
+    WriteAnnotation(vm::ArrayWrapper::GetAnnotation(obj), os);
+    // Initial values of the memory. Written as raw words instead of
+    // formatted numbers, since memories can be large.
+    vm::IntArray *memory = vm::ArrayWrapper::GetIntArray(obj);
+    const iroha::NumericWidth &width = memory->GetDataWidth();
+    uint64_t length = memory->GetLength();
+    string words;
+    for (uint64_t i = 0; i < length; ++i) {
+      if (width.IsWide()) {
+        words += iroha::Numeric(memory->ReadSingle(i), width).Format() + ",";
+        continue;
+      }
+      uint64_t v = memory->ReadSingle(i).GetValue0();
+      words.append((const char *)&v, sizeof(v));
+    }
+    os << ::Util::HashString(words) << "\n";
+  }
+
+  int num_visited_;
+  std::map<vm::Object *, int> visiting_;
+  std::map<vm::Object *, string> object_keys_;
+  std::map<vm::Method *, string> method_keys_;
+};
+
+}  // namespace
+
+bool SynthCache::IsEnabled() { return !Env::GetSynthCacheDir().empty(); }
+
+IDesign *SynthCache::Load(vm::VM *vm, vm::Object *obj, string *key,
+                          vector<string> *reports) {
+  key->clear();
+  reports->clear();
+  // The dot output, profile annotations and channel depths are produced
+  // while synthesizing.
+  vm::Profile *profile = vm->GetProfile();
+  if (!IsEnabled() || Env::DotOutput() || profile->HasInfo() ||
+      profile->HasChannelInfo()) {
+    return nullptr;
+  }
+  std::ostringstream os;
+  os << kCacheFormat << "\n"
+     << Env::GetVersion() << "\n"
+     << "prefix " << Env::GetModulePrefix() << "\n"
+     << "disable_opt " << Env::GetDisabledOptPasses() << "\n";
+  os << GetObjectKey(obj) << "\n";
+  *key = ::Util::HashString(os.str());
+
+  string path = GetCachePath(*key);
+  FILE *fp = fopen(path.c_str(), "r");
+  if (fp == nullptr) {
+    ++num_misses_;
+    return nullptr;
+  }
+  fclose(fp);
+  IDesign *design = Iroha::ReadDesignFromFile(path);
+  if (design == nullptr) {
+    // Broken entry. Overwritten by Store().
+    ++num_misses_;
+    return nullptr;
+  }
+  std::ifstream ifs(GetReportPath(*key));
+  string line;
+  while (std::getline(ifs, line)) {
+    reports->push_back(line);
+  }
+  LOG(INFO) << "Synth cache hit: " << path;
+  ++num_hits_;
+  return design;
+}
+
+void SynthCache::Store(const string &key, IDesign *design,
+                       const vector<string> &reports) {
+  if (key.empty()) {
+    return;
+  }
+  // Writes to temporary files and renames, so that a concurrent run
+  // doesn't read a partial file. The reports are written first, since
+  // the design file makes the entry valid.
+  string suffix = "." + std::to_string(getpid()) + "~";
+  string report_path = GetReportPath(key);
+  string tmp = report_path + suffix;
+  {
+    std::ofstream ofs(tmp);
+    for (const string &r : reports) {
+      ofs << r << "\n";
+    }
+  }
+  if (rename(tmp.c_str(), report_path.c_str()) != 0) {
+    remove(tmp.c_str());
+    return;
+  }
+  string path = GetCachePath(key);
+  tmp = path + suffix;
+  WriterAPI *writer = Iroha::CreateWriter(design);
+  writer->SetLanguage("");
+  writer->Write(tmp);
+  if (rename(tmp.c_str(), path.c_str()) != 0) {
+    remove(tmp.c_str());
+  }
+}
+
+string SynthCache::GetObjectKey(vm::Object *obj) {
+  KeyWriter writer;
+  return writer.GetObjectKey(obj);
+}
+
+int SynthCache::GetNumHits() { return num_hits_; }
+
+int SynthCache::GetNumMisses() { return num_misses_; }
+
+string SynthCache::GetCachePath(const string &key) {
+  return Env::GetSynthCacheDir() + "/" + key + ".iroha";
+}
+
+string SynthCache::GetReportPath(const string &key) {
+  return Env::GetSynthCacheDir() + "/" + key + ".report";
+}
+
+}  // namespace synth
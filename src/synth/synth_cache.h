@@ -0,0 +1,40 @@
+// -*- C++ -*-
+#ifndef _synth_synth_cache_h_
+#define _synth_synth_cache_h_
+
+#include "synth/common.h"
+
+namespace synth {
+
+// On disk cache of synthesized designs (--synth_cache [dir]).
+// Designs are stored in IR format with the reports of the synthesizer
+// (see DesignSynth::Report()). They are keyed by a hash of everything the
+// synthesizer reads from the object tree (bytecode and parse trees of
+// methods, member types and values, annotations) and the synth params.
+class SynthCache {
+ public:
+  static bool IsEnabled();
+  // Returns nullptr on miss. *key is set to the key to Store() the design
+  // synthesized for the miss. *reports are set on hit.
+  static IDesign *Load(vm::VM *vm, vm::Object *obj, string *key,
+                       vector<string> *reports);
+  static void Store(const string &key, IDesign *design,
+                    const vector<string> &reports);
+
+  // Hash of the object tree part of the key.
+  static string GetObjectKey(vm::Object *obj);
+
+  static int GetNumHits();
+  static int GetNumMisses();
+
+ private:
+  static string GetCachePath(const string &key);
+  static string GetReportPath(const string &key);
+
+  static int num_hits_;
+  static int num_misses_;
+};
+
+}  // namespace synth
+
+#endif  // _synth_synth_cache_h_
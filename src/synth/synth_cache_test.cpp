@@ -0,0 +1,59 @@
+#include "synth/synth_cache.h"
+
+#include "base/sym.h"
+#include "iroha/test_util.h"
+#include "karuta/annotation.h"
+#include "karuta/annotation_builder.h"
+#include "vm/array_wrapper.h"
+#include "vm/channel_wrapper.h"
+#include "vm/mailbox_wrapper.h"
+#include "vm/object.h"
+#include "vm/value.h"
+#include "vm/vm.h"
+
+namespace synth {
+
+static void SetMember(vm::Object *obj, const char *name,
+                      vm::Value::ValueType type, vm::Object *member) {
+  vm::Value *value = obj->LookupValue(sym_lookup(name), true);
+  value->type_ = type;
+  value->object_ = member;
+}
+
+static Annotation *DepthAnnotation(int depth) {
+  AnnotationKeyValueSet *params = AnnotationBuilder::BuildParamSet(
+      nullptr, AnnotationBuilder::BuildIntParam(sym_lookup("depth"), depth));
+  return new Annotation(params);
+}
+
+// An object with a channel and an array of 2 objects with a mailbox each.
+static vm::Object *NewTree(vm::VM *vm, int channel_width, int channel_depth,
+                           int mailbox_width) {
+  vm::Object *obj = vm->root_object_->Clone();
+  vm::Object *ch = vm::ChannelWrapper::NewChannel(
+      vm, channel_width, sym_lookup("c"), DepthAnnotation(channel_depth));
+  SetMember(obj, "c", vm::Value::OBJECT, ch);
+  vm::Object *arr = vm::ArrayWrapper::NewObjectArrayWrapper(vm, 2);
+  for (int i = 0; i < 2; ++i) {
+    vm::Object *elem = vm->root_object_->Clone();
+    int width = (i == 1) ? mailbox_width : 32;
+    vm::Object *mb =
+        vm::MailboxWrapper::NewMailbox(vm, width, sym_lookup("m"), nullptr);
+    SetMember(elem, "m", vm::Value::OBJECT, mb);
+    vm::ArrayWrapper::Set(arr, i, elem);
+  }
+  SetMember(obj, "a", vm::Value::OBJECT_ARRAY, arr);
+  return obj;
+}
+
+void TestSynthCache() {
+  vm::VM vm;
+  string key = SynthCache::GetObjectKey(NewTree(&vm, 32, 4, 32));
+  ASSERT(key == SynthCache::GetObjectKey(NewTree(&vm, 32, 4, 32)));
+  // Each of them changes the synthesized design, so misses the cache.
+  ASSERT(key != SynthCache::GetObjectKey(NewTree(&vm, 16, 4, 32)));
+  ASSERT(key != SynthCache::GetObjectKey(NewTree(&vm, 32, 8, 32)));
+  ASSERT(key != SynthCache::GetObjectKey(NewTree(&vm, 32, 4, 16)));
+}
+
+}  // namespace synth
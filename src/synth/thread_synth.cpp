@@ -146,6 +146,22 @@ bool ThreadSynth::Synth() {
   return true;
 }
 
+void ThreadSynth::ScheduleLoops() {
+  for (vm::Object *obj : obj_order_) {
+    for (auto jt : obj_methods_[obj].methods_) {
+      jt.second->ScheduleLoops();
+    }
+  }
+}
+
+void ThreadSynth::ReportLoops() {
+  for (vm::Object *obj : obj_order_) {
+    for (auto jt : obj_methods_[obj].methods_) {
+      jt.second->ReportLoops();
+    }
+  }
+}
+
 void ThreadSynth::SetPrimary() { is_primary_thread_ = true; }
 
 bool ThreadSynth::IsPrimary() { return is_primary_thread_; }
@@ -235,6 +251,9 @@ void ThreadSynth::MayGenerateExtIOMethod(vm::Method *method, bool is_output) {
 void ThreadSynth::SetIsTask(bool is_task) { is_task_ = is_task; }
 
 void ThreadSynth::RequestMethod(vm::Object *obj, const string &m) {
+  if (obj_methods_.find(obj) == obj_methods_.end()) {
+    obj_order_.push_back(obj);
+  }
   obj_methods_[obj].methods_[m] = nullptr;
 }
 
@@ -270,11 +289,11 @@ const string &ThreadSynth::GetEntryMethodName() { return entry_method_name_; }
 
 int ThreadSynth::GetIndex() const { return index_; }
 
-IInsn *ThreadSynth::InjectSubModuleCall(IState *st, IInsn *pseudo_call_insn,
+IInsn *ThreadSynth::InjectSubModuleCall(ThreadSynth *thr, IState *st,
+                                        IInsn *pseudo_call_insn,
                                         ITable *callee_tab) {
-  ITable *caller_tab = st->GetTable();
-  IResource *call_res =
-      Tool::FindOrCreateTaskCallResource(caller_tab, callee_tab);
+  ResourceSet *caller = thr->GetResourceSet();
+  IResource *call_res = Tool::FindOrCreateTaskCallResource(caller, callee_tab);
   if (call_res == nullptr) {
     return nullptr;
   }
@@ -292,7 +311,7 @@ IInsn *ThreadSynth::InjectSubModuleCall(IState *st, IInsn *pseudo_call_insn,
   IState *next_st = Tool::GetNextState(st);
   CHECK(next_st);
   IResource *ret =
-      Tool::FindOrCreateTaskReturnValueResource(caller_tab, callee_tab);
+      Tool::FindOrCreateTaskReturnValueResource(caller, callee_tab);
   if (ret == nullptr) {
     // TODO: This shouldn't happen. Put CHECK(false) here.
     // outputs_.size() == 1 in case of void return due to the default
@@ -316,8 +335,7 @@ IInsn *ThreadSynth::InjectDataFlowCall(ThreadSynth *thr, IState *st,
   DesignUtil::FindResourceByClassName(callee_tab, resource::kDataFlowIn, &df);
   CHECK(df.size() == 1);
   IResource *sreg = df[0]->GetParentResource();
-  ITable *caller_tab = st->GetTable();
-  IResource *w = Tool::FindOrCreateDataFlowCaller(caller_tab, sreg);
+  IResource *w = Tool::FindOrCreateDataFlowCaller(thr->GetResourceSet(), sreg);
   IInsn *iinsn = new IInsn(w);
   st->insns_.push_back(iinsn);
   for (IRegister *reg : pseudo_call_insn->inputs_) {
@@ -339,12 +357,13 @@ IInsn *ThreadSynth::InjectDataFlowCall(ThreadSynth *thr, IState *st,
   return iinsn;
 }
 
-IInsn *ThreadSynth::InjectExtStubCall(IState *st, IInsn *pseudo_call_insn,
+IInsn *ThreadSynth::InjectExtStubCall(ThreadSynth *thr, IState *st,
+                                      IInsn *pseudo_call_insn,
                                       const string &name, bool is_flow) {
   // ext-task-call or ext-flow-call
-  ITable *caller_tab = st->GetTable();
+  ResourceSet *caller = thr->GetResourceSet();
   IResource *call =
-      Tool::FindOrCreateExtStubCallResource(caller_tab, name, is_flow);
+      Tool::FindOrCreateExtStubCallResource(caller, name, is_flow);
   IInsn *insn = new IInsn(call);
   st->insns_.push_back(insn);
   bool need_width =
@@ -358,7 +377,7 @@ IInsn *ThreadSynth::InjectExtStubCall(IState *st, IInsn *pseudo_call_insn,
   // ext-task-wait or ext-flow-result.
   IState *next_st = Tool::GetNextState(st);
   IResource *wait =
-      Tool::FindOrCreateExtStubWaitResource(caller_tab, name, is_flow);
+      Tool::FindOrCreateExtStubWaitResource(caller, name, is_flow);
   IInsn *wait_insn = new IInsn(wait);
   wait_insn->depending_insns_.push_back(insn);
   next_st->insns_.push_back(wait_insn);
@@ -373,8 +392,8 @@ IInsn *ThreadSynth::InjectExtStubCall(IState *st, IInsn *pseudo_call_insn,
 }
 
 void ThreadSynth::AddExtStubResource(const string &name) {
-  (void)Tool::FindOrCreateExtStubCallResource(tab_, name, false);
-  (void)Tool::FindOrCreateExtStubWaitResource(tab_, name, false);
+  (void)Tool::FindOrCreateExtStubCallResource(resource_.get(), name, false);
+  (void)Tool::FindOrCreateExtStubWaitResource(resource_.get(), name, false);
 }
 
 }  // namespace synth
@@ -22,6 +22,8 @@ class ThreadSynth {
 
   bool Synth();
   bool Scan();
+  void ScheduleLoops();
+  void ReportLoops();
   // One primary thread in an object and takes care of unaccessed resources.
   void SetPrimary();
   bool IsPrimary();
@@ -41,13 +43,15 @@ class ThreadSynth {
   vector<TableCall> &GetTableCalls();
   const string &GetEntryMethodName();
   int GetIndex() const;
-  static IInsn *InjectSubModuleCall(IState *st, IInsn *pseudo_call_insn,
+  static IInsn *InjectSubModuleCall(ThreadSynth *thr, IState *st,
+                                    IInsn *pseudo_call_insn,
                                     ITable *callee_tab);
   static IInsn *InjectDataFlowCall(ThreadSynth *thr, IState *st,
                                    IInsn *pseudo_call_insn, ITable *callee_tab,
                                    bool no_wait);
-  static IInsn *InjectExtStubCall(IState *st, IInsn *pseudo_call_insn,
-                                  const string &name, bool is_flow);
+  static IInsn *InjectExtStubCall(ThreadSynth *thr, IState *st,
+                                  IInsn *pseudo_call_insn, const string &name,
+                                  bool is_flow);
 
  private:
   void AddExtStubResource(const string &name);
@@ -73,6 +77,8 @@ class ThreadSynth {
   // This or member object to its methods.
   // TODO: fix ordering by something stable instead of pointers to Object.
   map<vm::Object *, PerObject> obj_methods_;
+  // Keys of obj_methods_ in the order of requests.
+  vector<vm::Object *> obj_order_;
   int reg_name_index_;
   set<string> used_reg_names_;
 };
@@ -22,14 +22,13 @@ IState *Tool::GetNextState(IState *st) {
   return insn->target_states_[0];
 }
 
-IResource *Tool::FindOrCreateTaskCallResource(ITable *caller, ITable *callee) {
-  for (IResource *res : caller->resources_) {
-    if (resource::IsTaskCall(*res->GetClass()) &&
-        res->GetCalleeTable() == callee) {
-      return res;
-    }
+IResource *Tool::FindOrCreateTaskCallResource(ResourceSet *caller,
+                                              ITable *callee) {
+  IResource *res = caller->FindTaskCallResource(callee);
+  if (res != nullptr) {
+    return res;
   }
-  IResource *res = DesignTool::CreateTaskCallResource(caller, callee);
+  res = DesignTool::CreateTaskCallResource(caller->GetTable(), callee);
   IInsn *task_entry = DesignUtil::FindTaskEntryInsn(callee);
   if (task_entry == nullptr) {
     return nullptr;
@@ -42,7 +41,7 @@ IResource *Tool::FindOrCreateTaskCallResource(ITable *caller, ITable *callee) {
   return res;
 }
 
-IResource *Tool::FindOrCreateTaskReturnValueResource(ITable *caller,
+IResource *Tool::FindOrCreateTaskReturnValueResource(ResourceSet *caller,
                                                      ITable *callee) {
   // Find the return value writer.
   IState *return_st = callee->states_[callee->states_.size() - 1];
@@ -56,89 +55,58 @@ IResource *Tool::FindOrCreateTaskReturnValueResource(ITable *caller,
     return nullptr;
   }
   IResource *return_reg = writer->GetParentResource();
-  for (IResource *res : caller->resources_) {
-    if (res->GetParentResource() == return_reg) {
-      return res;
-    }
+  IResource *res = caller->FindChildResource(return_reg);
+  if (res != nullptr) {
+    return res;
   }
-  IResource *res =
-      DesignTool::CreateSharedRegReaderResource(caller, return_reg);
+  res = DesignTool::CreateSharedRegReaderResource(caller->GetTable(),
+                                                  return_reg);
   return res;
 }
 
-IInsn *Tool::FindArgInsn(ITable *tab, IResource *arg_res) {
-  for (size_t i = 0; i < tab->states_.size(); ++i) {
-    IState *st = tab->states_[i];
-    for (IInsn *insn : st->insns_) {
-      if (insn->GetResource() == arg_res) {
-        return insn;
-      }
-    }
+IResource *Tool::FindOrCreateDataFlowCaller(ResourceSet *caller,
+                                            IResource *sreg) {
+  IResource *res = caller->FindChildResource(sreg);
+  if (res != nullptr) {
+    return res;
   }
-  return nullptr;
-}
-
-IResource *Tool::FindOrCreateDataFlowCaller(ITable *caller, IResource *sreg) {
-  for (IResource *res : caller->resources_) {
-    if (res->GetParentResource() == sreg) {
-      return res;
-    }
-  }
-  IResource *res = DesignTool::CreateFifoWriterResource(caller, sreg);
+  res = DesignTool::CreateFifoWriterResource(caller->GetTable(), sreg);
   return res;
 }
 
-IResource *Tool::FindOrCreateExtStubCallResource(ITable *caller,
+IResource *Tool::FindOrCreateExtStubCallResource(ResourceSet *caller,
                                                  const string &name,
                                                  bool is_flow) {
-  for (IResource *res : caller->resources_) {
-    if (is_flow) {
-      if (!resource::IsExtFlowCall(*res->GetClass())) {
-        continue;
-      }
-    } else {
-      if (!resource::IsExtTaskCall(*res->GetClass())) {
-        continue;
-      }
-    }
-    if (res->GetParams()->GetExtTaskName() == name) {
-      return res;
-    }
+  IResource *res = caller->FindExtStubResource(name, is_flow, false);
+  if (res != nullptr) {
+    return res;
   }
   auto rcn = resource::kExtTaskCall;
   if (is_flow) {
     rcn = resource::kExtFlowCall;
   }
+  ITable *tab = caller->GetTable();
   IResourceClass *rc =
-      DesignUtil::FindResourceClass(caller->GetModule()->GetDesign(), rcn);
-  IResource *call = new IResource(caller, rc);
-  caller->resources_.push_back(call);
+      DesignUtil::FindResourceClass(tab->GetModule()->GetDesign(), rcn);
+  IResource *call = new IResource(tab, rc);
+  tab->resources_.push_back(call);
   call->GetParams()->SetExtTaskName(name);
   return call;
 }
 
-IResource *Tool::FindOrCreateExtStubWaitResource(ITable *caller,
+IResource *Tool::FindOrCreateExtStubWaitResource(ResourceSet *caller,
                                                  const string &name,
                                                  bool is_flow) {
-  for (IResource *res : caller->resources_) {
-    if (is_flow) {
-      if (!resource::IsExtFlowResult(*res->GetClass())) {
-        continue;
-      }
-    } else {
-      if (!resource::IsExtTaskWait(*res->GetClass())) {
-        continue;
-      }
-    }
-    if (res->GetParentResource()->GetParams()->GetExtTaskName() == name) {
-      return res;
-    }
+  IResource *res = caller->FindExtStubResource(name, is_flow, true);
+  if (res != nullptr) {
+    return res;
   }
   IResource *call = FindOrCreateExtStubCallResource(caller, name, is_flow);
+  ITable *tab = caller->GetTable();
   IResourceClass *rc = DesignUtil::FindResourceClass(
-      caller->GetModule()->GetDesign(), resource::kExtTaskWait);
-  IResource *wait = new IResource(caller, rc);
-  caller->resources_.push_back(wait);
+      tab->GetModule()->GetDesign(), resource::kExtTaskWait);
+  IResource *wait = new IResource(tab, rc);
+  tab->resources_.push_back(wait);
   wait->SetParentResource(call);
   return wait;
 }
@@ -11,20 +11,19 @@ class Tool {
  public:
   static void SetNextState(IState *cur, IState *next);
   static IState *GetNextState(IState *st);
-  static IResource *FindOrCreateTaskCallResource(ITable *caller,
+  // Finds resources in the caller by the indexes of its ResourceSet.
+  static IResource *FindOrCreateTaskCallResource(ResourceSet *caller,
                                                  ITable *callee);
-  static IResource *FindOrCreateTaskReturnValueResource(ITable *caller,
+  static IResource *FindOrCreateTaskReturnValueResource(ResourceSet *caller,
                                                         ITable *callee);
-  static IResource *FindOrCreateDataFlowCaller(ITable *caller, IResource *sreg);
-  static IResource *FindOrCreateExtStubCallResource(ITable *caller,
+  static IResource *FindOrCreateDataFlowCaller(ResourceSet *caller,
+                                               IResource *sreg);
+  static IResource *FindOrCreateExtStubCallResource(ResourceSet *caller,
                                                     const string &name,
                                                     bool is_flow);
-  static IResource *FindOrCreateExtStubWaitResource(ITable *caller,
+  static IResource *FindOrCreateExtStubWaitResource(ResourceSet *caller,
                                                     const string &name,
                                                     bool is_flow);
-
- private:
-  static IInsn *FindArgInsn(ITable *tab, IResource *arg_res);
 };
 
 }  // namespace synth
@@ -130,6 +130,12 @@ Object *ArrayWrapper::Get(Object *obj, int nth) {
   return data->objs_[nth];
 }
 
+int ArrayWrapper::GetObjectArraySize(Object *obj) {
+  CHECK(IsObjectArray(obj));
+  ArrayWrapperData *data = (ArrayWrapperData *)obj->object_specific_.get();
+  return data->objs_.size();
+}
+
 void ArrayWrapper::Set(Object *obj, int nth, Object *elem) {
   ArrayWrapperData *data = (ArrayWrapperData *)obj->object_specific_.get();
   CHECK(nth >= 0 && nth < (int)data->objs_.size());
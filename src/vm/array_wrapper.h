@@ -19,6 +19,7 @@ class ArrayWrapper {
   static Object *Copy(VM *vm, Object *obj);
 
   static Object *Get(Object *obj, int nth);
+  static int GetObjectArraySize(Object *obj);
   static void Set(Object *obj, int nth, Object *elem);
   static IntArray *GetIntArray(Object *obj);
   static Annotation *GetAnnotation(Object *obj);
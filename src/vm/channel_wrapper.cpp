@@ -1,7 +1,6 @@
 #include "vm/channel_wrapper.h"
 
-#include <list>
-
+#include "base/ring_buffer.h"
 #include "base/status.h"
 #include "iroha/numeric.h"
 #include "karuta/annotation.h"
@@ -10,34 +9,36 @@
 #include "vm/native_methods.h"
 #include "vm/native_objects.h"
 #include "vm/object.h"
+#include "vm/profile.h"
 #include "vm/thread.h"
 #include "vm/thread_queue.h"
 #include "vm/vm.h"
 
-using std::list;
-
 namespace vm {
 
 static const char *kChannelObjectKey = "channel";
+// Ids of the channels. Not reused even after the channels are collected.
+static int num_channels;
 
 class ChannelData : public ObjectSpecificData {
  public:
-  ChannelData(int width, sym_t name, Annotation *an)
-      : width_(width), name_(sym_cstr(name)), an_(an) {
-    if (an == nullptr) {
-      depth_ = 1;
-    } else {
-      depth_ = an_->GetDepth();
-    }
-  };
+  ChannelData(int id, int width, sym_t name, Annotation *an)
+      : id_(id),
+        width_(width),
+        name_(sym_cstr(name)),
+        depth_((an == nullptr) ? 1 : an->GetDepth()),
+        values_(depth_),
+        an_(an) {}
   virtual ~ChannelData(){};
 
   virtual const char *ObjectTypeKey() { return kChannelObjectKey; }
 
+  int id_;
   int width_;
   string name_;
-  list<iroha::NumericValue> values_;
   int depth_;
+  // Capacity is depth_.
+  RingBuffer<iroha::NumericValue> values_;
 
   ThreadQueue read_waiters_;
   ThreadQueue write_waiters_;
@@ -59,7 +60,8 @@ Object *ChannelWrapper::NewChannel(VM *vm, int width, sym_t name,
                                          &ChannelWrapper::ReadMethod, rets);
   m->SetSynthName(synth::kChannelRead);
 
-  pipe->object_specific_.reset(new ChannelData(width, name, an));
+  pipe->object_specific_.reset(
+      new ChannelData(num_channels++, width, name, an));
 
   return pipe;
 }
@@ -68,6 +70,12 @@ bool ChannelWrapper::IsChannel(Object *obj) {
   return (obj->ObjectTypeKey() == kChannelObjectKey);
 }
 
+int ChannelWrapper::ChannelId(Object *obj) {
+  CHECK(IsChannel(obj));
+  ChannelData *pipe_data = (ChannelData *)obj->object_specific_.get();
+  return pipe_data->id_;
+}
+
 const string &ChannelWrapper::ChannelName(Object *obj) {
   CHECK(IsChannel(obj));
   ChannelData *pipe_data = (ChannelData *)obj->object_specific_.get();
@@ -86,6 +94,12 @@ int ChannelWrapper::ChannelDepth(Object *obj) {
   return pipe_data->depth_;
 }
 
+Annotation *ChannelWrapper::ChannelAnnotation(Object *obj) {
+  CHECK(IsChannel(obj));
+  ChannelData *pipe_data = (ChannelData *)obj->object_specific_.get();
+  return pipe_data->an_;
+}
+
 void ChannelWrapper::ReadMethod(Thread *thr, Object *obj,
                                 const vector<Value> &args) {
   Value value;
@@ -98,18 +112,18 @@ void ChannelWrapper::ReadMethod(Thread *thr, Object *obj,
 
 bool ChannelWrapper::ReadValue(Thread *thr, Object *obj, Value *value) {
   ChannelData *pipe_data = (ChannelData *)obj->object_specific_.get();
-  if (pipe_data->values_.size() == 0) {
+  iroha::NumericValue v;
+  if (!pipe_data->values_.Pop(&v)) {
+    MayProfileBlock(thr, obj, false);
     BlockOnRead(thr, obj);
     return false;
   }
 
   value->type_ = Value::NUM;
-  iroha::NumericValue v = *(pipe_data->values_.begin());
   value->num_value_ = v;
   value->num_width_ = iroha::NumericWidth(false, pipe_data->width_);
-  pipe_data->values_.pop_front();
-  // Wake writers.
-  pipe_data->write_waiters_.ResumeAll();
+  // Wakes a writer for the freed slot.
+  pipe_data->write_waiters_.ResumeOne();
   return true;
 }
 
@@ -125,14 +139,25 @@ void ChannelWrapper::WriteMethod(Thread *thr, Object *obj,
 
 void ChannelWrapper::WriteValue(const Value &value, Thread *thr, Object *obj) {
   ChannelData *pipe_data = (ChannelData *)obj->object_specific_.get();
-  if (pipe_data->values_.size() == pipe_data->depth_) {
+  if (!pipe_data->values_.Push(value.num_value_)) {
+    MayProfileBlock(thr, obj, true);
     BlockOnWrite(thr, obj);
     return;
   }
-  const iroha::NumericValue &v = value.num_value_;
-  pipe_data->values_.push_back(v);
-  // Wake readers.
-  pipe_data->read_waiters_.ResumeAll();
+  Profile *profile = thr->GetVM()->GetProfile();
+  if (profile->IsEnabled()) {
+    profile->MarkChannelWrite(pipe_data->id_, pipe_data->values_.Size());
+  }
+  // Wakes a reader for the new item.
+  pipe_data->read_waiters_.ResumeOne();
+}
+
+void ChannelWrapper::MayProfileBlock(Thread *thr, Object *obj,
+                                     bool is_write) {
+  Profile *profile = thr->GetVM()->GetProfile();
+  if (profile->IsEnabled()) {
+    profile->MarkChannelBlock(ChannelId(obj), is_write);
+  }
 }
 
 void ChannelWrapper::BlockOnRead(Thread *thr, Object *obj) {
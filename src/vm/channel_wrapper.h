@@ -11,9 +11,12 @@ class ChannelWrapper {
   static Object *NewChannel(VM *vm, int width, sym_t name, Annotation *an);
 
   static bool IsChannel(Object *obj);
+  // Unique in the process.
+  static int ChannelId(Object *obj);
   static const string &ChannelName(Object *obj);
   static int ChannelWidth(Object *obj);
   static int ChannelDepth(Object *obj);
+  static Annotation *ChannelAnnotation(Object *obj);
 
   static void ReadMethod(Thread *thr, Object *obj, const vector<Value> &args);
   static void WriteMethod(Thread *thr, Object *obj, const vector<Value> &args);
@@ -22,6 +25,7 @@ class ChannelWrapper {
   static bool ReadValue(Thread *thr, Object *obj, Value *value);
 
  private:
+  static void MayProfileBlock(Thread *thr, Object *obj, bool is_write);
   static void BlockOnRead(Thread *thr, Object *obj);
   static void BlockOnWrite(Thread *thr, Object *obj);
 };
@@ -23,7 +23,9 @@ class NumericWidth;
 namespace vm {
 
 class EnumType;
+class FrameStack;
 class GC;
+class GCStats;
 class Insn;
 class IntArray;
 class Method;
@@ -35,6 +37,10 @@ class Thread;
 class Value;
 class VM;
 
+namespace executor {
+class DecodedMethod;
+}  // namespace executor
+
 }  // namespace vm
 
 #endif  // _vm_common_h_
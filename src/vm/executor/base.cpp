@@ -63,8 +63,8 @@ void Base::ExecBinop() {
     // TODO: Annotate other types of insns.
   }
   if (dst->type_.value_type_ != Value::NUM) {
-    if (dst->type_.value_type_ == Value::NONE) {
-      CHECK(IsTopLevel());
+    // Results of non top level methods are typed by TypeChecker.
+    if (IsTopLevel() && dst->type_.value_type_ == Value::NONE) {
       RetryBinopWithType();
     } else {
       ExecNonNumResultBinop();
@@ -186,6 +186,37 @@ void Base::ExecArrayRead() {
   }
 }
 
+void Base::ExecArrayReadAt(uint64_t index) {
+  Object *array_obj = VAL(oreg()).object_;
+  CHECK(array_obj);
+  Value &lhs_value = VAL(dreg(0));
+  if (ArrayWrapper::IsIntArray(array_obj)) {
+    IntArray *array = ArrayWrapper::GetIntArray(array_obj);
+    lhs_value.num_value_ = array->ReadAt(index);
+  } else {
+    CHECK(ArrayWrapper::IsObjectArray(array_obj));
+    lhs_value.type_ = Value::OBJECT;
+    lhs_value.object_ = ArrayWrapper::Get(array_obj, index);
+  }
+}
+
+void Base::ExecLoadAndRead(Insn *load, Insn *read, const uint64_t *index) {
+  insn_ = load;
+  if (op() == OP_LOAD_OBJ) {
+    ExecLoadObj();
+  } else if (!ExecMemberAccess()) {
+    return;
+  }
+  insn_ = read;
+  if (op() == OP_MEMBER_READ) {
+    ExecMemberAccess();
+  } else if (index != nullptr) {
+    ExecArrayReadAt(*index);
+  } else {
+    ExecArrayRead();
+  }
+}
+
 void Base::ExecArrayWrite() {
   CHECK(oreg() != nullptr);
   Object *array_obj = VAL(oreg()).object_;
@@ -270,7 +301,7 @@ void Base::ExecLoadObj() {
     } else {
       src_obj = frame_->obj_;
     }
-    obj_value = src_obj->LookupValue(insn_->label_, false);
+    obj_value = LookupMember(src_obj);
     CHECK(obj_value) << "Failed to LoadObj: " << sym_cstr(insn_->label_);
     CHECK(obj_value->IsObjectType()) << " is not a object";
     dst_value.object_ = obj_value->object_;
@@ -392,16 +423,14 @@ bool Base::ExecFuncall() {
   if (callee_method == nullptr) {
     return true;
   }
-  vector<Value> args;
-  for (size_t i = 0; i < insn_->src_regs_.size(); ++i) {
-    args.push_back(VAL(insn_->src_regs_[i]));
-  }
   auto fn = callee_method->GetMethodFunc();
   if (fn != nullptr) {
     // Native method call (implementation in C++).
     // Copy types of argument values too, since (most of) native methods
     // don't assume argument types.
+    vector<Value> args;
     for (size_t i = 0; i < insn_->src_regs_.size(); ++i) {
+      args.push_back(VAL(insn_->src_regs_[i]));
       args[i].type_ = sreg(i)->type_.value_type_;
       args[i].num_width_ = sreg(i)->type_.num_width_;
     }
@@ -411,7 +440,7 @@ bool Base::ExecFuncall() {
     }
   } else {
     // Karuta method.
-    SetupCalleeFrame(obj, callee_method, args);
+    SetupCalleeFrame(obj, callee_method);
     return true;
   }
   return false;
@@ -434,7 +463,7 @@ Method *Base::LookupMethod(Object **obj) {
   CHECK(obj_value.IsObjectType())
       << "reg id=" << oreg()->id_ << " is not an object.";
   *obj = obj_value.object_;
-  Value *value = (*obj)->LookupValue(insn_->label_, false);
+  Value *value = LookupMember(*obj);
   if (!value) {
     Status::os(Status::USER_ERROR)
         << "method not found: " << sym_cstr(insn_->label_);
@@ -445,6 +474,19 @@ Method *Base::LookupMethod(Object **obj) {
   return value->method_;
 }
 
+Value *Base::LookupMember(Object *obj) {
+  unsigned long stamp = obj->members_.GetStamp();
+  if (insn_->cached_stamp_ == stamp) {
+    return insn_->cached_value_;
+  }
+  Value *value = obj->LookupValue(insn_->label_, false);
+  if (value != nullptr) {
+    insn_->cached_stamp_ = stamp;
+    insn_->cached_value_ = value;
+  }
+  return value;
+}
+
 void Base::ExecFuncallDone() {
   for (size_t i = 0; i < insn_->dst_regs_.size() && i < frame_->returns_.size();
        ++i) {
@@ -453,17 +495,16 @@ void Base::ExecFuncallDone() {
   frame_->returns_.clear();
 }
 
-void Base::SetupCalleeFrame(Object *obj, Method *callee_method,
-                            const vector<Value> &args) {
+void Base::SetupCalleeFrame(Object *obj, Method *callee_method) {
   MethodFrame *callee_frame = thr_->PushMethodFrame(obj, callee_method);
-  for (size_t i = 0; i < args.size(); ++i) {
-    callee_frame->reg_values_[i] = args[i];
+  for (size_t i = 0; i < insn_->src_regs_.size(); ++i) {
+    callee_frame->reg_values_[i] = VAL(insn_->src_regs_[i]);
   }
 }
 
 bool Base::ExecMemberAccess() {
   Object *obj = VAL(oreg()).object_;
-  Value *member = obj->LookupValue(insn_->label_, false);
+  Value *member = LookupMember(obj);
   if (member == nullptr) {
     Status::os(Status::USER_ERROR)
         << "member not found: " << sym_cstr(insn_->label_);
@@ -496,14 +537,16 @@ bool Base::ExecMemberAccess() {
     Register *src_reg = sreg(0);
     Value &src = VAL(src_reg);
     member->CopyDataFrom(src, src_reg->type_.num_width_);
-    member->type_ = src_reg->type_.value_type_;
+    if (IsTopLevel()) {
+      member->type_ = src_reg->type_.value_type_;
+    }
   }
   return true;
 }
 
 void Base::ExecBitRange() {
   Register *dst = dreg(0);
-  if (dst->type_.value_type_ == Value::NONE) {
+  if (IsTopLevel()) {
     InsnAnnotator::AnnotateBitRangeInsn(insn_);
   }
   int h = VAL(sreg(1)).num_value_.GetValue0();
@@ -525,7 +568,7 @@ void Base::ExecMemberReadWithCheck() {
   Value &obj_value = VAL(oreg());
   CHECK(oreg()->type_.value_type_ == Value::OBJECT);
   Object *obj = obj_value.object_;
-  Value *member = obj->LookupValue(insn_->label_, false);
+  Value *member = LookupMember(obj);
   Register *dst_reg = dreg(0);
   dst_reg->type_.value_type_ = member->type_;
   dst_reg->type_.object_name_ = member->type_object_name_;
@@ -616,13 +659,9 @@ bool Base::ExecCustomOp() {
   Method *op_method = value->method_;
   compiler::Compiler::CompileMethod(thr_->GetVM(), type_obj, op_method);
   CHECK(!op_method->IsCompileFailure());
-  vector<Value> args;
-  for (size_t i = 0; i < insn_->src_regs_.size(); ++i) {
-    args.push_back(VAL(insn_->src_regs_[i]));
-  }
   auto fn = op_method->GetMethodFunc();
   CHECK(fn == nullptr);
-  SetupCalleeFrame(type_obj, op_method, args);
+  SetupCalleeFrame(type_obj, op_method);
   return true;
 }
 
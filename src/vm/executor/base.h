@@ -24,10 +24,12 @@ class Base {
   bool ExecFuncall();
   void ExecFuncallDone();
   Method *LookupMethod(Object **obj);
+  // Looks up label_ of the insn in obj with the inline cache.
+  Value *LookupMember(Object *obj);
   Method *LookupCompiledMethod(Object **obj);
   void ExecLoadObj();
-  void SetupCalleeFrame(Object *obj, Method *callee_method,
-                        const vector<Value> &args);
+  // Writes the source registers to the arguments of the callee.
+  void SetupCalleeFrame(Object *obj, Method *callee_method);
   void ExecStr();
   void ExecNum();
   void ExecBinop();
@@ -41,6 +43,13 @@ class Base {
   bool ExecGoto();
   void ExecBitRange();
   bool ExecYield();
+  // Superinstructions for non top level methods.
+  // Loads an object by OP_LOAD_OBJ or OP_MEMBER_READ and reads its member
+  // or element by the next insn. index is the constant index if the read
+  // is an OP_ARRAY_READ with it.
+  void ExecLoadAndRead(Insn *load, Insn *read, const uint64_t *index);
+  // OP_ARRAY_READ with a constant index.
+  void ExecArrayReadAt(uint64_t index);
 
   void ExecMemberReadWithCheck();
   bool ExecFuncallWithCheck();
@@ -0,0 +1,728 @@
+#include "vm/executor/threaded.h"
+
+#include <map>
+#include <set>
+
+#include "vm/insn.h"
+#include "vm/method.h"
+#include "vm/profile.h"
+#include "vm/register.h"
+#include "vm/thread.h"
+
+using std::map;
+using std::set;
+
+namespace vm {
+namespace executor {
+
+static bool IsNarrow(const Register *reg) {
+  const iroha::NumericWidth &w = reg->type_.num_width_;
+  return (reg->type_.value_type_ == Value::NUM && !w.IsSigned() &&
+          w.GetWidth() > 0 && w.GetWidth() <= 64);
+}
+
+static uint64_t WidthMask(const Register *reg) {
+  int w = reg->type_.num_width_.GetWidth();
+  if (w >= 64) {
+    return ~0ULL;
+  }
+  return (1ULL << w) - 1;
+}
+
+// Compares as DoCompare*64().
+static bool Compare64(const Value *regs, const DecodedInsn &di) {
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  bool r;
+  if (di.compare_op_ == iroha::COMPARE_LT) {
+    r = (a < b);
+  } else if (di.compare_op_ == iroha::COMPARE_GT) {
+    r = (a > b);
+  } else {
+    r = (a == b);
+  }
+  return r != di.negate_;
+}
+
+bool Threaded::Run(Profile *profile) {
+  Method *method = frame_->method_;
+  DecodedMethod *dm = GetDecodedMethod(method);
+  const DecodedInsn *insns = dm->insns_.data();
+  size_t num_insns = dm->insns_.size();
+  regs_ = frame_->reg_values_;
+  long *counters = nullptr;
+  if (profile != nullptr) {
+    counters = profile->GetCounters(method);
+  }
+  profile_ = profile;
+  counters_ = counters;
+  while (frame_->pc_ < num_insns) {
+    if (counters != nullptr) {
+      profile->Mark(thr_, counters, frame_->pc_);
+    }
+    const DecodedInsn &di = insns[frame_->pc_];
+    if (di.handler_(this, di)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Threaded::RunLocal() {
+  DecodedMethod *dm = frame_->method_->GetDecodedMethod();
+  CHECK(dm != nullptr);
+  const DecodedInsn *insns = dm->insns_.data();
+  size_t num_insns = dm->insns_.size();
+  regs_ = frame_->reg_values_;
+  while (frame_->pc_ < num_insns) {
+    const DecodedInsn &di = insns[frame_->pc_];
+    if (!di.is_local_) {
+      return;
+    }
+    if ((di.handler_ == DoIf || di.handler_ == DoGoto ||
+         di.handler_ == DoCompareIf64) &&
+        !thr_->CanJumpLocally()) {
+      // Let Thread::Run() report the busy loop.
+      return;
+    }
+    di.handler_(this, di);
+  }
+}
+
+void Threaded::Prepare(Method *method) { GetDecodedMethod(method); }
+
+DecodedMethod *Threaded::GetDecodedMethod(Method *method) {
+  DecodedMethod *dm = method->GetDecodedMethod();
+  if (dm != nullptr) {
+    return dm;
+  }
+  // Register types of a non toplevel method are fixed by the compiler,
+  // so handlers can be selected once here.
+  CHECK(!method->IsTopLevel());
+  dm = new DecodedMethod;
+  dm->insns_.resize(method->insns_.size());
+  for (size_t i = 0; i < method->insns_.size(); ++i) {
+    Decode(method->insns_[i], &dm->insns_[i]);
+  }
+  FuseInsns(method, dm);
+  method->SetDecodedMethod(dm);
+  return dm;
+}
+
+void Threaded::Decode(Insn *insn, DecodedInsn *di) {
+  di->handler_ = DoFallback;
+  di->dst_ = -1;
+  di->src0_ = -1;
+  di->src1_ = -1;
+  di->jump_target_ = insn->jump_target_;
+  di->dst_width_ = nullptr;
+  di->op_width_ = nullptr;
+  di->num_ = nullptr;
+  di->mask_ = ~0ULL;
+  di->imm_ = 0;
+  di->binop_ = iroha::BINOP_AND;
+  di->compare_op_ = iroha::COMPARE_EQ;
+  di->negate_ = false;
+  di->is_local_ = false;
+  di->insn_ = insn;
+
+  Register *dst = nullptr;
+  Register *lhs = nullptr;
+  Register *rhs = nullptr;
+  if (insn->dst_regs_.size() > 0) {
+    dst = insn->dst_regs_[0];
+    di->dst_ = dst->id_;
+    di->dst_width_ = &dst->type_.num_width_;
+  }
+  if (insn->src_regs_.size() > 0) {
+    lhs = insn->src_regs_[0];
+    di->src0_ = lhs->id_;
+  }
+  if (insn->src_regs_.size() > 1) {
+    rhs = insn->src_regs_[1];
+    di->src1_ = rhs->id_;
+  }
+  bool num_dst = (dst != nullptr && dst->type_.value_type_ == Value::NUM);
+  switch (insn->op_) {
+    case OP_NOP:
+      di->handler_ = DoNop;
+      break;
+    case OP_NUM:
+      di->handler_ = DoNum;
+      di->num_ = &lhs->initial_num_;
+      break;
+    case OP_ADD:
+      if (num_dst) {
+        di->handler_ = DoAdd;
+      }
+      break;
+    case OP_SUB:
+      if (num_dst) {
+        di->handler_ = DoSub;
+      }
+      break;
+    case OP_MUL:
+    case OP_DIV:
+      if (num_dst) {
+        di->handler_ = DoCalcBinOpWithFixup;
+        di->binop_ =
+            (insn->op_ == OP_MUL) ? iroha::BINOP_MUL : iroha::BINOP_DIV;
+        di->op_width_ = &rhs->type_.num_width_;
+      }
+      break;
+    case OP_LSHIFT:
+    case OP_RSHIFT:
+      if (num_dst) {
+        di->handler_ = DoCalcBinOpWithFixup;
+        di->binop_ = (insn->op_ == OP_LSHIFT) ? iroha::BINOP_LSHIFT
+                                               : iroha::BINOP_RSHIFT;
+        di->op_width_ = &lhs->type_.num_width_;
+      }
+      break;
+    case OP_AND:
+    case OP_OR:
+    case OP_XOR:
+      if (num_dst) {
+        di->handler_ = DoCalcBinOp;
+        if (insn->op_ == OP_AND) {
+          di->binop_ = iroha::BINOP_AND;
+        } else if (insn->op_ == OP_OR) {
+          di->binop_ = iroha::BINOP_OR;
+        } else {
+          di->binop_ = iroha::BINOP_XOR;
+        }
+        di->op_width_ = &lhs->type_.num_width_;
+      }
+      break;
+    case OP_ASSIGN:
+      if (num_dst) {
+        di->handler_ = DoAssign;
+        di->op_width_ = &rhs->type_.num_width_;
+      }
+      break;
+    case OP_LT:
+    case OP_GT:
+    case OP_LTE:
+    case OP_GTE:
+    case OP_EQ:
+    case OP_NE:
+      if (dst != nullptr && dst->type_.value_type_ != Value::NUM &&
+          lhs->type_.value_type_ == Value::NUM &&
+          rhs->type_.value_type_ == Value::NUM) {
+        di->handler_ = DoCompare;
+        if (insn->op_ == OP_LT || insn->op_ == OP_GTE) {
+          di->compare_op_ = iroha::COMPARE_LT;
+        } else if (insn->op_ == OP_GT || insn->op_ == OP_LTE) {
+          di->compare_op_ = iroha::COMPARE_GT;
+        } else {
+          di->compare_op_ = iroha::COMPARE_EQ;
+        }
+        di->negate_ =
+            (insn->op_ == OP_NE || insn->op_ == OP_GTE || insn->op_ == OP_LTE);
+      }
+      break;
+    case OP_PRE_INC:
+      di->handler_ = DoPreInc;
+      break;
+    case OP_PRE_DEC:
+      di->handler_ = DoPreDec;
+      break;
+    case OP_IF:
+      di->handler_ = DoIf;
+      break;
+    case OP_GOTO:
+      di->handler_ = DoGoto;
+      break;
+    default:
+      break;
+  }
+  MayDecodeNarrow(insn, di);
+  DecodedHandler h = di->handler_;
+  di->is_local_ =
+      (h == DoNop || h == DoIf || h == DoGoto || h == DoNum64 ||
+       h == DoAdd64 || h == DoSub64 || h == DoMul64 || h == DoAnd64 ||
+       h == DoOr64 || h == DoXor64 || h == DoLshift64 || h == DoRshift64 ||
+       h == DoAssign64 || h == DoCompareLt64 || h == DoCompareGt64 ||
+       h == DoCompareEq64 || h == DoPreInc64 || h == DoPreDec64);
+}
+
+void Threaded::MayDecodeNarrow(Insn *insn, DecodedInsn *di) {
+  if (di->handler_ == DoFallback) {
+    return;
+  }
+  Register *dst = nullptr;
+  Register *lhs = nullptr;
+  Register *rhs = nullptr;
+  if (insn->dst_regs_.size() > 0) {
+    dst = insn->dst_regs_[0];
+    di->mask_ = WidthMask(dst);
+  }
+  if (insn->src_regs_.size() > 0) {
+    lhs = insn->src_regs_[0];
+  }
+  if (insn->src_regs_.size() > 1) {
+    rhs = insn->src_regs_[1];
+  }
+  bool narrow_binop = (dst != nullptr && lhs != nullptr && rhs != nullptr &&
+                       IsNarrow(dst) && IsNarrow(lhs) && IsNarrow(rhs));
+  switch (insn->op_) {
+    case OP_NUM:
+      if (IsNarrow(dst) && !lhs->initial_num_.type_.IsWide()) {
+        di->handler_ = DoNum64;
+        di->imm_ = lhs->initial_num_.GetValue().value_[0] & di->mask_;
+      }
+      break;
+    case OP_ADD:
+      if (narrow_binop) {
+        di->handler_ = DoAdd64;
+      }
+      break;
+    case OP_SUB:
+      if (narrow_binop) {
+        di->handler_ = DoSub64;
+      }
+      break;
+    case OP_MUL:
+      if (narrow_binop) {
+        di->handler_ = DoMul64;
+      }
+      break;
+    case OP_AND:
+      if (narrow_binop) {
+        di->handler_ = DoAnd64;
+      }
+      break;
+    case OP_OR:
+      if (narrow_binop) {
+        di->handler_ = DoOr64;
+      }
+      break;
+    case OP_XOR:
+      if (narrow_binop) {
+        di->handler_ = DoXor64;
+      }
+      break;
+    case OP_LSHIFT:
+    case OP_RSHIFT:
+      // The shifted value is truncated to the width of lhs.
+      if (narrow_binop && dst->type_.num_width_.GetWidth() ==
+                              lhs->type_.num_width_.GetWidth()) {
+        di->handler_ = (insn->op_ == OP_LSHIFT) ? DoLshift64 : DoRshift64;
+      }
+      break;
+    case OP_ASSIGN:
+      if (IsNarrow(dst) && IsNarrow(rhs)) {
+        di->handler_ = DoAssign64;
+      }
+      break;
+    case OP_LT:
+    case OP_GT:
+    case OP_LTE:
+    case OP_GTE:
+    case OP_EQ:
+    case OP_NE:
+      // Leaves 64 bits values to Compare0() to keep its signedness.
+      if (IsNarrow(lhs) && IsNarrow(rhs) &&
+          lhs->type_.num_width_.GetWidth() < 64 &&
+          rhs->type_.num_width_.GetWidth() < 64) {
+        if (di->compare_op_ == iroha::COMPARE_LT) {
+          di->handler_ = DoCompareLt64;
+        } else if (di->compare_op_ == iroha::COMPARE_GT) {
+          di->handler_ = DoCompareGt64;
+        } else {
+          di->handler_ = DoCompareEq64;
+        }
+      }
+      break;
+    case OP_PRE_INC:
+      if (IsNarrow(dst)) {
+        di->handler_ = DoPreInc64;
+      }
+      break;
+    case OP_PRE_DEC:
+      if (IsNarrow(dst)) {
+        di->handler_ = DoPreDec64;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void Threaded::FuseInsns(Method *method, DecodedMethod *dm) {
+  auto &insns = method->insns_;
+  // Registers only set by an OP_NUM.
+  map<Register *, int> num_defs;
+  set<Register *> nums;
+  for (Insn *insn : insns) {
+    if (insn->op_ == OP_MEMBER_WRITE || insn->op_ == OP_ARRAY_WRITE) {
+      continue;
+    }
+    for (Register *reg : insn->dst_regs_) {
+      ++num_defs[reg];
+    }
+    if (insn->op_ == OP_NUM && insn->src_regs_[0] == insn->dst_regs_[0]) {
+      nums.insert(insn->dst_regs_[0]);
+    }
+  }
+  for (size_t i = 0; i < insns.size(); ++i) {
+    Insn *insn = insns[i];
+    DecodedInsn &di = dm->insns_[i];
+    if (insn->op_ != OP_ARRAY_READ || insn->src_regs_.size() != 1) {
+      continue;
+    }
+    Register *idx = insn->src_regs_[0];
+    if (nums.find(idx) != nums.end() && num_defs[idx] == 1 &&
+        IsNarrow(idx) && !idx->initial_num_.type_.IsWide()) {
+      di.handler_ = DoArrayReadConst;
+      di.imm_ = idx->initial_num_.GetValue().value_[0] & WidthMask(idx);
+    }
+  }
+  // Decides with the handlers before the fusion, so that each
+  // DecodedInsn still can run the insn by itself.
+  vector<DecodedHandler> handlers;
+  for (const DecodedInsn &di : dm->insns_) {
+    handlers.push_back(di.handler_);
+  }
+  for (size_t i = 0; i + 1 < insns.size(); ++i) {
+    DecodedInsn &di = dm->insns_[i];
+    DecodedHandler h = handlers[i];
+    DecodedHandler nh = handlers[i + 1];
+    bool is_compare =
+        (h == DoCompareLt64 || h == DoCompareGt64 || h == DoCompareEq64);
+    if (h == DoNum64 && nh == DoAdd64) {
+      di.handler_ = DoNumAdd64;
+    } else if (is_compare && nh == DoIf &&
+               dm->insns_[i + 1].src0_ == di.dst_) {
+      di.handler_ = DoCompareIf64;
+    } else if (is_compare && insns[i + 1]->op_ == OP_YIELD &&
+               i + 2 < insns.size() && handlers[i + 2] == DoIf &&
+               dm->insns_[i + 2].src0_ == di.dst_) {
+      // Conditions of if and loop statements.
+      di.handler_ = DoCompareYieldIf64;
+      di.is_local_ = false;
+    } else if ((insns[i]->op_ == OP_LOAD_OBJ ||
+                insns[i]->op_ == OP_MEMBER_READ) &&
+               (insns[i + 1]->op_ == OP_MEMBER_READ ||
+                insns[i + 1]->op_ == OP_ARRAY_READ) &&
+               insns[i + 1]->obj_reg_ == insns[i]->dst_regs_[0]) {
+      di.handler_ = DoLoadAndRead;
+    }
+  }
+}
+
+void Threaded::MarkNext() {
+  if (counters_ != nullptr) {
+    profile_->Mark(thr_, counters_, frame_->pc_ + 1);
+  }
+}
+
+bool Threaded::DoFallback(Threaded *ex, const DecodedInsn &di) {
+  return ex->ExecInsn(di.insn_);
+}
+
+bool Threaded::DoNop(Threaded *ex, const DecodedInsn &di) {
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoNum(Threaded *ex, const DecodedInsn &di) {
+  iroha::Numeric::CopyValueWithWidth(di.num_->GetValue(), di.num_->type_,
+                                     *di.dst_width_, nullptr,
+                                     &ex->regs_[di.dst_].num_value_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoAdd(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  iroha::NumericValue *res = &regs[di.dst_].num_value_;
+  iroha::Op::Add0(regs[di.src0_].num_value_, regs[di.src1_].num_value_, res);
+  iroha::Op::FixupValueWidth(*di.dst_width_, res);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoSub(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  iroha::NumericValue *res = &regs[di.dst_].num_value_;
+  iroha::Op::Sub0(regs[di.src0_].num_value_, regs[di.src1_].num_value_, res);
+  iroha::Op::FixupValueWidth(*di.dst_width_, res);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoCalcBinOp(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  iroha::Op::CalcBinOp(di.binop_, regs[di.src0_].num_value_,
+                       regs[di.src1_].num_value_, *di.op_width_,
+                       &regs[di.dst_].num_value_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoCalcBinOpWithFixup(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  iroha::NumericValue *res = &regs[di.dst_].num_value_;
+  iroha::Op::CalcBinOp(di.binop_, regs[di.src0_].num_value_,
+                       regs[di.src1_].num_value_, *di.op_width_, res);
+  iroha::Op::FixupValueWidth(*di.dst_width_, res);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoAssign(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  iroha::NumericValue *res = &regs[di.dst_].num_value_;
+  iroha::Numeric::CopyValueWithWidth(regs[di.src1_].num_value_, *di.op_width_,
+                                     *di.dst_width_, nullptr, res);
+  iroha::Op::FixupValueWidth(*di.dst_width_, res);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoCompare(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  bool r = iroha::Op::Compare0(di.compare_op_, regs[di.src0_].num_value_,
+                               regs[di.src1_].num_value_);
+  if (di.negate_) {
+    r = !r;
+  }
+  regs[di.dst_].SetBool(r);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoPreInc(Threaded *ex, const DecodedInsn &di) {
+  iroha::NumericValue *target = &ex->regs_[di.dst_].num_value_;
+  iroha::NumericValue n1;
+  n1.SetValue0(1);
+  iroha::NumericValue res;
+  iroha::Op::Add0(*target, n1, &res);
+  iroha::Op::FixupValueWidth(*di.dst_width_, &res);
+  *target = res;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoPreDec(Threaded *ex, const DecodedInsn &di) {
+  iroha::NumericValue *target = &ex->regs_[di.dst_].num_value_;
+  iroha::NumericValue n1;
+  n1.SetValue0(1);
+  iroha::NumericValue res;
+  iroha::Op::Sub0(*target, n1, &res);
+  iroha::Op::FixupValueWidth(*di.dst_width_, &res);
+  *target = res;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoIf(Threaded *ex, const DecodedInsn &di) {
+  if (ex->regs_[di.src0_].enum_val_.val) {
+    ++ex->frame_->pc_;
+    return false;
+  }
+  ex->frame_->pc_ = di.jump_target_;
+  return ex->thr_->OnJump();
+}
+
+bool Threaded::DoGoto(Threaded *ex, const DecodedInsn &di) {
+  ex->frame_->pc_ = di.jump_target_;
+  return ex->thr_->OnJump();
+}
+
+bool Threaded::DoAdd64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = (a + b) & di.mask_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoSub64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = (a - b) & di.mask_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoMul64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = (a * b) & di.mask_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoAnd64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = a & b;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoOr64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = a | b;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoXor64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = a ^ b;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoLshift64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = (b >= 64) ? 0 : ((a << b) & di.mask_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoRshift64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  uint64_t a = regs[di.src0_].num_value_.value_[0];
+  uint64_t b = regs[di.src1_].num_value_.value_[0];
+  regs[di.dst_].num_value_.value_[0] = (b >= 64) ? 0 : (a >> b);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoNum64(Threaded *ex, const DecodedInsn &di) {
+  ex->regs_[di.dst_].num_value_.value_[0] = di.imm_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoAssign64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  regs[di.dst_].num_value_.value_[0] =
+      regs[di.src1_].num_value_.value_[0] & di.mask_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoCompareLt64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  bool r = (regs[di.src0_].num_value_.value_[0] <
+            regs[di.src1_].num_value_.value_[0]);
+  regs[di.dst_].SetBool(r != di.negate_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoCompareGt64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  bool r = (regs[di.src0_].num_value_.value_[0] >
+            regs[di.src1_].num_value_.value_[0]);
+  regs[di.dst_].SetBool(r != di.negate_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoCompareEq64(Threaded *ex, const DecodedInsn &di) {
+  Value *regs = ex->regs_;
+  bool r = (regs[di.src0_].num_value_.value_[0] ==
+            regs[di.src1_].num_value_.value_[0]);
+  regs[di.dst_].SetBool(r != di.negate_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoPreInc64(Threaded *ex, const DecodedInsn &di) {
+  uint64_t &v = ex->regs_[di.dst_].num_value_.value_[0];
+  v = (v + 1) & di.mask_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoPreDec64(Threaded *ex, const DecodedInsn &di) {
+  uint64_t &v = ex->regs_[di.dst_].num_value_.value_[0];
+  v = (v - 1) & di.mask_;
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoArrayReadConst(Threaded *ex, const DecodedInsn &di) {
+  ex->insn_ = di.insn_;
+  ex->ExecArrayReadAt(di.imm_);
+  ++ex->frame_->pc_;
+  return false;
+}
+
+bool Threaded::DoNumAdd64(Threaded *ex, const DecodedInsn &di) {
+  const DecodedInsn &add = (&di)[1];
+  Value *regs = ex->regs_;
+  regs[di.dst_].num_value_.value_[0] = di.imm_;
+  ex->MarkNext();
+  uint64_t a = regs[add.src0_].num_value_.value_[0];
+  uint64_t b = regs[add.src1_].num_value_.value_[0];
+  regs[add.dst_].num_value_.value_[0] = (a + b) & add.mask_;
+  ex->frame_->pc_ += 2;
+  return false;
+}
+
+bool Threaded::DoCompareIf64(Threaded *ex, const DecodedInsn &di) {
+  bool r = Compare64(ex->regs_, di);
+  ex->regs_[di.dst_].SetBool(r);
+  ex->MarkNext();
+  ++ex->frame_->pc_;
+  if (r) {
+    ++ex->frame_->pc_;
+    return false;
+  }
+  ex->frame_->pc_ = (&di)[1].jump_target_;
+  return ex->thr_->OnJump();
+}
+
+bool Threaded::DoCompareYieldIf64(Threaded *ex, const DecodedInsn &di) {
+  bool r = Compare64(ex->regs_, di);
+  ex->regs_[di.dst_].SetBool(r);
+  ex->MarkNext();
+  ++ex->frame_->pc_;
+  // Same as the fallback of OP_YIELD. The OP_IF runs by itself after the
+  // suspension.
+  bool need_suspend = ex->ExecYield();
+  if (need_suspend) {
+    ++ex->frame_->pc_;
+    return true;
+  }
+  ex->MarkNext();
+  ++ex->frame_->pc_;
+  if (r) {
+    ++ex->frame_->pc_;
+    return false;
+  }
+  ex->frame_->pc_ = (&di)[2].jump_target_;
+  return ex->thr_->OnJump();
+}
+
+bool Threaded::DoLoadAndRead(Threaded *ex, const DecodedInsn &di) {
+  const DecodedInsn &read = (&di)[1];
+  const uint64_t *index = nullptr;
+  if (read.handler_ == DoArrayReadConst) {
+    index = &read.imm_;
+  }
+  ex->MarkNext();
+  ex->ExecLoadAndRead(di.insn_, read.insn_, index);
+  ex->frame_->pc_ += 2;
+  return false;
+}
+
+}  // namespace executor
+}  // namespace vm
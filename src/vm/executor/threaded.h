@@ -0,0 +1,125 @@
+// -*- C++ -*-
+#ifndef _vm_executor_threaded_h_
+#define _vm_executor_threaded_h_
+
+#include "iroha/numeric.h"
+#include "vm/executor/executor.h"
+
+namespace vm {
+namespace executor {
+
+class DecodedInsn;
+class Threaded;
+
+// Returns true to suspend. Each handler updates pc by itself.
+typedef bool (*DecodedHandler)(Threaded *ex, const DecodedInsn &di);
+
+// Pre decoded form of an Insn. Register operands are resolved to
+// slot indexes of MethodFrame::reg_values_.
+class DecodedInsn {
+ public:
+  DecodedHandler handler_;
+  int dst_;
+  int src0_;
+  int src1_;
+  int jump_target_;
+  // Width of the destination.
+  const iroha::NumericWidth *dst_width_;
+  // Width given to iroha::Op::CalcBinOp().
+  const iroha::NumericWidth *op_width_;
+  // OP_NUM.
+  const iroha::Numeric *num_;
+  // For *64 handlers. Mask of the destination width and the
+  // constant value of OP_NUM.
+  uint64_t mask_;
+  uint64_t imm_;
+  iroha::BinOp binop_;
+  iroha::CompareOp compare_op_;
+  bool negate_;
+  // true if the handler only touches registers of the frame and doesn't
+  // allocate numeric storage. i.e. can run in parallel with other threads.
+  bool is_local_;
+  // Original insn. Used by the fallback handler.
+  Insn *insn_;
+};
+
+class DecodedMethod {
+ public:
+  vector<DecodedInsn> insns_;
+};
+
+// Executes non toplevel methods with handler pointer dispatch over
+// DecodedInsn-s. Insns without a specialized handler (e.g. OP_TL_*,
+// funcalls and object accesses) fall back to Executor::ExecInsn().
+class Threaded : public Executor {
+ public:
+  Threaded(Thread *thread, MethodFrame *frame)
+      : Executor(thread, frame), profile_(nullptr), counters_(nullptr) {}
+
+  // Runs insns from the current pc. Returns true to suspend.
+  bool Run(Profile *profile);
+  // Runs insns from the current pc while they are local.
+  void RunLocal();
+
+  // Decodes the method if it isn't yet.
+  static void Prepare(Method *method);
+
+ private:
+  static DecodedMethod *GetDecodedMethod(Method *method);
+  static void Decode(Insn *insn, DecodedInsn *di);
+  static void MayDecodeNarrow(Insn *insn, DecodedInsn *di);
+  // Replaces handlers of frequent sequences of insns with
+  // superinstructions. A superinstruction takes operands of the following
+  // insns from their DecodedInsn-s, which keep their own handlers for
+  // jumps to there.
+  static void FuseInsns(Method *method, DecodedMethod *dm);
+  // Counts the insn at pc + 1 run by a superinstruction.
+  void MarkNext();
+
+  static bool DoFallback(Threaded *ex, const DecodedInsn &di);
+  static bool DoNop(Threaded *ex, const DecodedInsn &di);
+  static bool DoNum(Threaded *ex, const DecodedInsn &di);
+  static bool DoAdd(Threaded *ex, const DecodedInsn &di);
+  static bool DoSub(Threaded *ex, const DecodedInsn &di);
+  static bool DoCalcBinOp(Threaded *ex, const DecodedInsn &di);
+  static bool DoCalcBinOpWithFixup(Threaded *ex, const DecodedInsn &di);
+  static bool DoAssign(Threaded *ex, const DecodedInsn &di);
+  static bool DoCompare(Threaded *ex, const DecodedInsn &di);
+  static bool DoPreInc(Threaded *ex, const DecodedInsn &di);
+  static bool DoPreDec(Threaded *ex, const DecodedInsn &di);
+  static bool DoIf(Threaded *ex, const DecodedInsn &di);
+  static bool DoGoto(Threaded *ex, const DecodedInsn &di);
+  // Unsigned values up to 64 bits on raw uint64_t.
+  static bool DoNum64(Threaded *ex, const DecodedInsn &di);
+  static bool DoAdd64(Threaded *ex, const DecodedInsn &di);
+  static bool DoSub64(Threaded *ex, const DecodedInsn &di);
+  static bool DoMul64(Threaded *ex, const DecodedInsn &di);
+  static bool DoAnd64(Threaded *ex, const DecodedInsn &di);
+  static bool DoOr64(Threaded *ex, const DecodedInsn &di);
+  static bool DoXor64(Threaded *ex, const DecodedInsn &di);
+  static bool DoLshift64(Threaded *ex, const DecodedInsn &di);
+  static bool DoRshift64(Threaded *ex, const DecodedInsn &di);
+  static bool DoAssign64(Threaded *ex, const DecodedInsn &di);
+  static bool DoCompareLt64(Threaded *ex, const DecodedInsn &di);
+  static bool DoCompareGt64(Threaded *ex, const DecodedInsn &di);
+  static bool DoCompareEq64(Threaded *ex, const DecodedInsn &di);
+  static bool DoPreInc64(Threaded *ex, const DecodedInsn &di);
+  static bool DoPreDec64(Threaded *ex, const DecodedInsn &di);
+  static bool DoArrayReadConst(Threaded *ex, const DecodedInsn &di);
+  // Superinstructions.
+  static bool DoNumAdd64(Threaded *ex, const DecodedInsn &di);
+  static bool DoCompareIf64(Threaded *ex, const DecodedInsn &di);
+  static bool DoCompareYieldIf64(Threaded *ex, const DecodedInsn &di);
+  static bool DoLoadAndRead(Threaded *ex, const DecodedInsn &di);
+
+  // == frame_->reg_values_
+  Value *regs_;
+  // Set while profiling.
+  Profile *profile_;
+  long *counters_;
+};
+
+}  // namespace executor
+}  // namespace vm
+
+#endif  // _vm_executor_threaded_h_
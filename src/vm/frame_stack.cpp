@@ -0,0 +1,82 @@
+#include "vm/frame_stack.h"
+
+#include "base/stl_util.h"
+#include "vm/method.h"
+#include "vm/method_frame.h"
+#include "vm/register.h"
+#include "vm/value.h"
+
+namespace vm {
+
+static const size_t kChunkSize = 1024;
+
+FrameStack::FrameStack() : depth_(0), chunk_index_(0), chunk_top_(0) {}
+
+FrameStack::~FrameStack() {
+  STLDeleteValues(&frames_);
+  for (Value *chunk : chunks_) {
+    delete[] chunk;
+  }
+}
+
+MethodFrame *FrameStack::Push(Object *obj, Method *method) {
+  if (depth_ == frames_.size()) {
+    frames_.push_back(new MethodFrame);
+  }
+  MethodFrame *frame = frames_[depth_];
+  ++depth_;
+  frame->method_ = method;
+  frame->pc_ = 0;
+  frame->obj_ = obj;
+  frame->returns_.clear();
+  frame->objs_.clear();
+  frame->saved_chunk_index_ = chunk_index_;
+  frame->saved_chunk_top_ = chunk_top_;
+  size_t num_regs = method->method_regs_.size();
+  frame->reg_values_ = AllocRegs(num_regs);
+  frame->num_regs_ = num_regs;
+  for (size_t i = 0; i < num_regs; ++i) {
+    Value &local_val = frame->reg_values_[i];
+    Register *reg = method->method_regs_[i];
+    local_val = Value();
+    local_val.type_ = reg->type_.value_type_;
+    local_val.enum_val_.enum_type = reg->type_.enum_type_;
+    local_val.num_width_ = reg->type_.num_width_;
+  }
+  return frame;
+}
+
+void FrameStack::Pop() {
+  CHECK(depth_ > 0);
+  --depth_;
+  MethodFrame *frame = frames_[depth_];
+  chunk_index_ = frame->saved_chunk_index_;
+  chunk_top_ = frame->saved_chunk_top_;
+  frame->reg_values_ = nullptr;
+  frame->num_regs_ = 0;
+}
+
+Value *FrameStack::AllocRegs(size_t num) {
+  if (num == 0) {
+    return nullptr;
+  }
+  if (chunk_index_ < chunks_.size() &&
+      chunk_top_ + num > chunk_sizes_[chunk_index_]) {
+    // Regs of a frame should be contiguous.
+    ++chunk_index_;
+    chunk_top_ = 0;
+  }
+  while (chunk_index_ < chunks_.size() && num > chunk_sizes_[chunk_index_]) {
+    ++chunk_index_;
+  }
+  if (chunk_index_ == chunks_.size()) {
+    size_t size = (num > kChunkSize) ? num : kChunkSize;
+    chunks_.push_back(new Value[size]);
+    chunk_sizes_.push_back(size);
+  }
+  Value *regs = chunks_[chunk_index_] + chunk_top_;
+  chunk_top_ += num;
+  return regs;
+}
+
+}  // namespace vm
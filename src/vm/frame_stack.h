@@ -0,0 +1,38 @@
+// -*- C++ -*-
+#ifndef _vm_frame_stack_h_
+#define _vm_frame_stack_h_
+
+#include "vm/common.h"
+
+namespace vm {
+
+// Per thread storage of MethodFrame-s and their register values.
+//
+// Frames are kept for each call depth and register values are
+// allocated from chunks of contiguous Value-s in LIFO order, so
+// method calls don't allocate once the stack reached the depth before.
+class FrameStack {
+ public:
+  FrameStack();
+  ~FrameStack();
+
+  MethodFrame *Push(Object *obj, Method *method);
+  void Pop();
+
+ private:
+  Value *AllocRegs(size_t num);
+
+  // Frames of each depth. Reused.
+  vector<MethodFrame *> frames_;
+  size_t depth_;
+
+  vector<Value *> chunks_;
+  vector<size_t> chunk_sizes_;
+  // Allocation point.
+  size_t chunk_index_;
+  size_t chunk_top_;
+};
+
+}  // namespace vm
+
+#endif  // _vm_frame_stack_h_
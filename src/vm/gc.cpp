@@ -1,5 +1,7 @@
 #include "vm/gc.h"
 
+#include <sys/time.h>
+
 #include "vm/method_frame.h"
 #include "vm/object.h"
 #include "vm/thread.h"
@@ -7,17 +9,42 @@
 
 namespace vm {
 
-GC::GC(VM *vm, set<Thread *> *threads, set<Object *> *objs)
-    : vm_(vm), threads_(threads), objs_(objs) {}
+static long GetTimeUsec() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec * 1000000L + tv.tv_usec;
+}
+
+GCStats::GCStats()
+    : num_young_(0),
+      num_full_(0),
+      pause_usec_(0),
+      num_live_(0),
+      num_freed_(0),
+      total_pause_usec_(0),
+      total_freed_(0) {}
+
+GC::GC(VM *vm, vector<Thread *> *threads, vector<Object *> *old_objs,
+       vector<Object *> *young_objs, unsigned int epoch)
+    : vm_(vm),
+      threads_(threads),
+      old_objs_(old_objs),
+      young_objs_(young_objs),
+      epoch_(epoch),
+      num_live_(0),
+      num_freed_(0) {}
 
-void GC::Run(VM *vm, set<Thread *> *threads, set<Object *> *objs) {
-  GC gc(vm, threads, objs);
-  gc.Collect();
+void GC::Run(VM *vm, vector<Thread *> *threads, vector<Object *> *old_objs,
+             vector<Object *> *young_objs, unsigned int epoch, bool is_full,
+             GCStats *stats) {
+  GC gc(vm, threads, old_objs, young_objs, epoch);
+  gc.Collect(is_full, stats);
 }
 
-void GC::Collect() {
-  AddRoot(vm_->root_object_);
-  AddRoot(vm_->kernel_object_);
+void GC::Collect(bool is_full, GCStats *stats) {
+  long start = GetTimeUsec();
+  ScanObject(vm_->root_object_);
+  ScanObject(vm_->kernel_object_);
 
   for (Thread *th : *threads_) {
     vector<MethodFrame *> &frame_stack = th->MethodStack();
@@ -25,67 +52,80 @@ void GC::Collect() {
       AddRootFromMethodFrame(frame);
     }
   }
-  LOG(INFO) << "GC: Allocated size=" << objs_->size()
-            << " Root size=" << reachables_.size();
-  frontier_ = reachables_;
+  LOG(INFO) << "GC: " << (is_full ? "full" : "young")
+            << " Old size=" << old_objs_->size()
+            << " Young size=" << young_objs_->size()
+            << " Root size=" << frontier_.size();
   Scan();
-  LOG(INFO) << "GC: Reachables size=" << reachables_.size();
-  Sweep();
-}
+  LOG(INFO) << "GC: Reachables size=" << num_live_;
+  if (is_full) {
+    Sweep(old_objs_);
+  }
+  Sweep(young_objs_);
+  // Promotes survivors.
+  old_objs_->insert(old_objs_->end(), young_objs_->begin(),
+                    young_objs_->end());
+  young_objs_->clear();
+  LOG(INFO) << "GC: Garbages count=" << num_freed_;
 
-void GC::AddRoot(Object *obj) {
-  if (obj) {
-    reachables_.insert(obj);
+  if (is_full) {
+    ++stats->num_full_;
+  } else {
+    ++stats->num_young_;
   }
+  stats->pause_usec_ = GetTimeUsec() - start;
+  stats->num_live_ = num_live_;
+  stats->num_freed_ = num_freed_;
+  stats->total_pause_usec_ += stats->pause_usec_;
+  stats->total_freed_ += num_freed_;
 }
 
 void GC::AddRootFromMethodFrame(MethodFrame *frame) {
-  AddRoot(frame->obj_);
-  for (Value &reg : frame->reg_values_) {
-    AddRoot(reg.object_);
+  ScanObject(frame->obj_);
+  for (size_t i = 0; i < frame->num_regs_; ++i) {
+    ScanObject(frame->reg_values_[i].object_);
   }
   for (Value &reg : frame->returns_) {
-    AddRoot(reg.object_);
+    ScanObject(reg.object_);
+  }
+}
+
+void GC::ScanObject(Object *obj) {
+  if (obj == nullptr || obj->gc_epoch_ == epoch_) {
+    return;
   }
+  obj->gc_epoch_ = epoch_;
+  ++num_live_;
+  frontier_.push_back(obj);
 }
 
 void GC::Scan() {
   while (frontier_.size() > 0) {
-    Object *obj = *(frontier_.begin());
-    frontier_.erase(obj);
-    ScanObject(obj);
+    Object *obj = frontier_.back();
+    frontier_.pop_back();
+    ScanMembers(obj);
   }
 }
 
-void GC::ScanObject(Object *obj) {
-  if (obj == nullptr) {
-    return;
-  }
+void GC::ScanMembers(Object *obj) {
   for (auto &it : obj->members_) {
-    Value &value = it.second;
-    if (value.object_) {
-      Object *o = value.object_;
-      if (reachables_.find(o) == reachables_.end()) {
-        frontier_.insert(o);
-        reachables_.insert(o);
-      }
-    }
+    ScanObject(it.second.object_);
   }
   obj->Scan(this);
 }
 
-void GC::Sweep() {
-  set<Object *> garbages;
-  for (Object *o : *objs_) {
-    if (reachables_.find(o) == reachables_.end()) {
-      garbages.insert(o);
+void GC::Sweep(vector<Object *> *objs) {
+  size_t n = 0;
+  for (Object *o : *objs) {
+    if (o->gc_epoch_ == epoch_) {
+      (*objs)[n] = o;
+      ++n;
+    } else {
+      delete o;
+      ++num_freed_;
     }
   }
-  LOG(INFO) << "GC: Garbages count=" << garbages.size();
-  for (Object *o : garbages) {
-    objs_->erase(o);
-    delete o;
-  }
+  objs->resize(n);
 }
 
 }  // namespace vm
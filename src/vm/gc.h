@@ -2,35 +2,61 @@
 #ifndef _vm_gc_h_
 #define _vm_gc_h_
 
-#include <set>
-
 #include "vm/common.h"
 
-using std::set;
-
 namespace vm {
 
+class GCStats {
+ public:
+  GCStats();
+
+  int num_young_;
+  int num_full_;
+  // Of the last collection.
+  long pause_usec_;
+  long num_live_;
+  long num_freed_;
+  // Accumulated.
+  long total_pause_usec_;
+  long total_freed_;
+};
+
+// Mark and sweep collector. Objects are marked by setting the current
+// epoch to Object::gc_epoch_.
+//
+// Objects allocated since the last collection are young. A young
+// collection sweeps only the young objects and promotes the survivors to
+// old objects, which are swept by full collections. Both still mark the
+// whole heap from the roots, since there is no write barrier to track
+// references from old objects to young ones.
 class GC {
  public:
-  GC(VM *vm, set<Thread *> *threads, set<Object *> *objs);
+  GC(VM *vm, vector<Thread *> *threads, vector<Object *> *old_objs,
+     vector<Object *> *young_objs, unsigned int epoch);
 
-  static void Run(VM *vm, set<Thread *> *threads, set<Object *> *objs);
+  static void Run(VM *vm, vector<Thread *> *threads,
+                  vector<Object *> *old_objs, vector<Object *> *young_objs,
+                  unsigned int epoch, bool is_full, GCStats *stats);
 
+  // Marks the object and its members reachable.
   void ScanObject(Object *obj);
 
  private:
-  void Collect();
-  void AddRoot(Object *obj);
+  void Collect(bool is_full, GCStats *stats);
   void AddRootFromMethodFrame(MethodFrame *frame);
   void Scan();
-  void Sweep();
+  void ScanMembers(Object *obj);
+  void Sweep(vector<Object *> *objs);
 
   VM *vm_;
-  set<Thread *> *threads_;
-  set<Object *> *objs_;
+  vector<Thread *> *threads_;
+  vector<Object *> *old_objs_;
+  vector<Object *> *young_objs_;
+  unsigned int epoch_;
 
-  set<Object *> reachables_;
-  set<Object *> frontier_;
+  vector<Object *> frontier_;
+  long num_live_;
+  long num_freed_;
 };
 
 }  // namespace vm
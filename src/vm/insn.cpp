@@ -15,7 +15,9 @@ Insn::Insn()
       jump_target_(-1),
       label_(nullptr),
       insn_expr_(nullptr),
-      insn_stmt_(nullptr) {}
+      insn_stmt_(nullptr),
+      cached_stamp_(0),
+      cached_value_(nullptr) {}
 
 void Insn::Dump() const {
   DumpStream ds(cout);
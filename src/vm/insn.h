@@ -23,6 +23,10 @@ class Insn {
   sym_t label_;
   fe::Expr *insn_expr_;
   fe::Stmt *insn_stmt_;
+  // Inline cache of the member lookup of label_. Valid while the stamp
+  // of the receiver's MemberTable is same.
+  unsigned long cached_stamp_;
+  Value *cached_value_;
 };
 
 class InsnType {
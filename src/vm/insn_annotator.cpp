@@ -148,6 +148,9 @@ void InsnAnnotator::TryType(Insn *insn) {
     return;
   }
   if (insn->op_ == OP_ASSIGN) {
+    if (!method_->IsTopLevel()) {
+      TypeAssignedTemporary(insn);
+    }
     if (insn->src_regs_[0]->type_.value_type_ != Value::NONE) {
       if (insn->dst_regs_[0]->GetIsDeclaredType()) {
         CHECK(insn->dst_regs_[0]->type_.value_type_ ==
@@ -243,6 +246,30 @@ void InsnAnnotator::TypeMemberAccess(Insn *insn) {
   }
 }
 
+// Temporaries of comma and ternary expressions take the types of values
+// assigned to them. The widest one is used if numbers of different widths
+// are assigned (e.g. c ? a : b).
+void InsnAnnotator::TypeAssignedTemporary(Insn *insn) {
+  Register *dst = insn->dst_regs_[0];
+  Register *src = insn->src_regs_[1];
+  if (dst == src || dst->GetIsDeclaredType() ||
+      src->type_.value_type_ == Value::NONE) {
+    return;
+  }
+  if (dst->type_.value_type_ == Value::NONE) {
+    dst->type_ = src->type_;
+    dst->type_.is_const_ = false;
+    auto it = objs_.find(src);
+    if (it != objs_.end()) {
+      objs_[dst] = it->second;
+    }
+  } else if (dst->type_.value_type_ == Value::NUM &&
+             src->type_.value_type_ == Value::NUM) {
+    dst->type_.num_width_ = iroha::NumericWidth::CommonWidth(
+        dst->type_.num_width_, src->type_.num_width_);
+  }
+}
+
 void InsnAnnotator::AnnotateBitRangeInsn(Insn *insn) {
   if (insn->src_regs_[0]->type_.value_type_ == Value::NUM) {
     insn->dst_regs_[0]->type_.value_type_ = Value::NUM;
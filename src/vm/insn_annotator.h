@@ -35,6 +35,7 @@ class InsnAnnotator {
   void TypeReturnValues(Insn *insn);
   void TypeMemberAccess(Insn *insn);
   void TypeArrayRead(Insn *insn);
+  void TypeAssignedTemporary(Insn *insn);
   void PropagateType();
   void TryPropagate(Insn *insn, std::set<Register *> *propagated);
 
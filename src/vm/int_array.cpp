@@ -8,6 +8,8 @@
 namespace vm {
 
 static const int PAGE_SIZE = 1024;
+// Larger arrays use pages, so that the storage is allocated on demand.
+static const uint64_t kMaxDenseLength = 1ULL << 26;
 
 struct IntArrayPage {
   IntArrayPage(const iroha::NumericWidth &w);
@@ -39,6 +41,27 @@ IntArray *IntArray::Copy(const IntArray *src) {
   return new IntArray(si);
 }
 
+IntArray *IntArray::CreateBank(IntArray *mem, int num_banks, bool is_block,
+                               int nth) {
+  uint64_t length = mem->GetLength();
+  uint64_t bank_length = (length + num_banks - 1) / num_banks;
+  vector<uint64_t> shape;
+  shape.push_back(bank_length);
+  IntArray *bank = new IntArray(mem->data_width_, shape);
+  for (uint64_t i = 0; i < bank_length; ++i) {
+    uint64_t addr;
+    if (is_block) {
+      addr = nth * bank_length + i;
+    } else {
+      addr = i * num_banks + nth;
+    }
+    if (addr < length) {
+      bank->WriteSingle(i, mem->data_width_, mem->ReadSingle(addr));
+    }
+  }
+  return bank;
+}
+
 IntArray::IntArray(const iroha::NumericWidth &width,
                    const vector<uint64_t> &shape)
     : shape_(shape), data_width_(width) {
@@ -46,11 +69,18 @@ IntArray::IntArray(const iroha::NumericWidth &width,
   for (uint64_t s : shape_) {
     size_ *= s;
   }
+  InitDenseStorage();
 }
 
-IntArray::IntArray(const IntArray *src) {
-  data_width_ = src->GetDataWidth();
-  size_ = src->GetLength();
+IntArray::IntArray(const IntArray *src)
+    : shape_(src->shape_),
+      size_(src->size_),
+      data_width_(src->data_width_),
+      dense_bytes_(src->dense_bytes_),
+      dense8_(src->dense8_),
+      dense16_(src->dense16_),
+      dense32_(src->dense32_),
+      dense64_(src->dense64_) {
   for (const auto it : src->pages_) {
     IntArrayPage *p = new IntArrayPage(data_width_);
     *p = *(it.second);
@@ -63,8 +93,84 @@ void IntArray::Write(const vector<uint64_t> &indexes,
   WriteSingle(GetIndex(indexes), data.type_, data.GetValue());
 }
 
+void IntArray::InitDenseStorage() {
+  dense_bytes_ = 0;
+  int w = data_width_.GetWidth();
+  if (size_ == 0 || size_ > kMaxDenseLength || w <= 0 || w > 64) {
+    return;
+  }
+  if (w <= 8) {
+    dense_bytes_ = 1;
+    dense8_.resize(size_, 0);
+  } else if (w <= 16) {
+    dense_bytes_ = 2;
+    dense16_.resize(size_, 0);
+  } else if (w <= 32) {
+    dense_bytes_ = 4;
+    dense32_.resize(size_, 0);
+  } else {
+    dense_bytes_ = 8;
+    dense64_.resize(size_, 0);
+  }
+}
+
+iroha::NumericValue IntArray::ReadDense(uint64_t addr) const {
+  uint64_t v;
+  switch (dense_bytes_) {
+    case 1:
+      v = dense8_[addr];
+      break;
+    case 2:
+      v = dense16_[addr];
+      break;
+    case 4:
+      v = dense32_[addr];
+      break;
+    default:
+      v = dense64_[addr];
+      break;
+  }
+  iroha::NumericValue value;
+  int w = data_width_.GetWidth();
+  if (data_width_.IsSigned() && w < 64 && ((v >> (w - 1)) & 1)) {
+    // Sign extends and lets iroha make the canonical form.
+    v |= ~((1ULL << w) - 1);
+    value.SetValue0(v);
+    iroha::Op::FixupValueWidth(data_width_, &value);
+  } else {
+    value.SetValue0(v);
+  }
+  return value;
+}
+
+void IntArray::WriteDense(uint64_t addr, const iroha::NumericWidth &width,
+                          const iroha::NumericValue &data) {
+  iroha::NumericValue value;
+  iroha::Numeric::CopyValueWithWidth(data, width, data_width_, nullptr,
+                                     &value);
+  uint64_t v = value.GetValue0();
+  switch (dense_bytes_) {
+    case 1:
+      dense8_[addr] = v;
+      break;
+    case 2:
+      dense16_[addr] = v;
+      break;
+    case 4:
+      dense32_[addr] = v;
+      break;
+    default:
+      dense64_[addr] = v;
+      break;
+  }
+}
+
 void IntArray::WriteSingle(uint64_t addr, const iroha::NumericWidth &width,
                            const iroha::NumericValue &data) {
+  if (dense_bytes_ > 0 && addr < size_) {
+    WriteDense(addr, width, data);
+    return;
+  }
   IntArrayPage *p = FindPage(addr);
   int offset = (addr % PAGE_SIZE);
   iroha::Numeric::CopyValueWithWidth(data, width, p->width_, nullptr,
@@ -89,7 +195,17 @@ iroha::NumericValue IntArray::Read(const vector<uint64_t> &indexes) {
   return ReadSingle(GetIndex(indexes));
 }
 
+iroha::NumericValue IntArray::ReadAt(uint64_t index) {
+  if (shape_.size() == 0) {
+    return ReadSingle(0);
+  }
+  return ReadSingle(index % shape_[0]);
+}
+
 iroha::NumericValue IntArray::ReadSingle(uint64_t addr) {
+  if (dense_bytes_ > 0 && addr < size_) {
+    return ReadDense(addr);
+  }
   IntArrayPage *p = FindPage(addr);
   int offset = (addr % PAGE_SIZE);
   return p->data_[offset];
@@ -13,6 +13,10 @@ namespace vm {
 
 class IntArrayPage;
 
+// Fixed size arrays of data width up to 64 bits are stored densely in a
+// vector of the narrowest of uint8_t, uint16_t, uint32_t and uint64_t
+// which can hold the width. Others (e.g. unlimited main memory) and
+// accesses outside of the length are stored in sparse pages.
 class IntArray {
  public:
   IntArray(const iroha::NumericWidth &width, const vector<uint64_t> &shape);
@@ -22,8 +26,15 @@ class IntArray {
   static IntArray *Create(const iroha::NumericWidth &data_width,
                           const vector<uint64_t> &shape);
   static IntArray *Copy(const IntArray *mem);
+  // Creates nth bank of the array partitioned into num_banks banks.
+  // Element i goes to bank i / ceil(length / num_banks) if is_block,
+  // otherwise to bank i % num_banks.
+  static IntArray *CreateBank(IntArray *mem, int num_banks, bool is_block,
+                              int nth);
 
   iroha::NumericValue Read(const vector<uint64_t> &indexes);
+  // Same as Read() with one index.
+  iroha::NumericValue ReadAt(uint64_t index);
   iroha::NumericValue ReadSingle(uint64_t addr);
   void Write(const vector<uint64_t> &indexes, const iroha::Numeric &data);
   void WriteSingle(uint64_t addr, const iroha::NumericWidth &type,
@@ -43,6 +54,12 @@ class IntArray {
   bool ImageIO(const string &fn, const string &format, bool save);
 
  private:
+  void InitDenseStorage();
+  // Returns the value in the dense storage as the canonical form of
+  // data_width_.
+  iroha::NumericValue ReadDense(uint64_t addr) const;
+  void WriteDense(uint64_t addr, const iroha::NumericWidth &width,
+                  const iroha::NumericValue &data);
   IntArrayPage *FindPage(uint64_t addr);
   uint64_t GetIndex(const vector<uint64_t> &indexes);
   bool BinaryIO(FILE *fp, bool save);
@@ -51,6 +68,13 @@ class IntArray {
   const vector<uint64_t> shape_;
   uint64_t size_;
   iroha::NumericWidth data_width_;
+  // Bytes of an element in the dense storage. 0 if it isn't used.
+  int dense_bytes_;
+  // One of them is used depending on dense_bytes_.
+  vector<uint8_t> dense8_;
+  vector<uint16_t> dense16_;
+  vector<uint32_t> dense32_;
+  vector<uint64_t> dense64_;
   std::map<uint64_t, IntArrayPage *> pages_;
 };
 
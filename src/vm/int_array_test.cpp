@@ -1,5 +1,7 @@
 #include "vm/int_array.h"
 
+#include <sys/time.h>
+
 #include "iroha/numeric.h"
 #include "iroha/test_util.h"
 
@@ -43,4 +45,99 @@ void TestIntArray() {
   }
 }
 
+void TestDenseIntArray() {
+  vector<uint64_t> shape;
+  shape.push_back(256);
+  {
+    // Dense (uint8_t) and paged (extra page) storage.
+    iroha::NumericWidth w(false, 8);
+    std::unique_ptr<IntArray> a(IntArray::Create(w, shape));
+    iroha::NumericWidth t(false, 32);
+    iroha::NumericValue v;
+    v.SetValue0(0x1ff);
+    a->WriteSingle(255, t, v);
+    a->WriteSingle(256, t, v);
+    ASSERT(a->ReadSingle(255).GetValue0() == 0xff);
+    ASSERT((a->ReadSingle(256).GetValue0() & 0xff) == 0xff);
+    ASSERT(a->ReadSingle(254).GetValue0() == 0);
+    std::unique_ptr<IntArray> b(IntArray::Copy(a.get()));
+    ASSERT(b->ReadSingle(255).GetValue0() == 0xff);
+    ASSERT(b->GetShape().size() == 1);
+  }
+  {
+    // Signed values are returned in the same form as iroha makes.
+    iroha::NumericWidth w(true, 12);
+    std::unique_ptr<IntArray> a(IntArray::Create(w, shape));
+    iroha::NumericWidth t(true, 32);
+    iroha::NumericValue zero, v;
+    iroha::Op::MakeConst0(0, &zero);
+    iroha::Op::MakeConst0(5, &v);
+    iroha::NumericValue minus;
+    iroha::Op::Sub0(zero, v, &minus);
+    a->WriteSingle(1, t, minus);
+    iroha::NumericValue expected;
+    iroha::Numeric::CopyValueWithWidth(minus, t, w, nullptr, &expected);
+    ASSERT(a->ReadSingle(1).GetValue0() == expected.GetValue0());
+  }
+}
+
+void TestIntArrayBank() {
+  iroha::NumericWidth w(false, 32);
+  vector<uint64_t> shape;
+  shape.push_back(10);
+  std::unique_ptr<IntArray> a(IntArray::Create(w, shape));
+  iroha::NumericValue v;
+  for (int i = 0; i < 10; ++i) {
+    v.SetValue0(i);
+    a->WriteSingle(i, w, v);
+  }
+  {
+    std::unique_ptr<IntArray> b(IntArray::CreateBank(a.get(), 4, false, 1));
+    ASSERT(b->GetLength() == 3);
+    ASSERT(b->ReadSingle(0).GetValue0() == 1);
+    ASSERT(b->ReadSingle(1).GetValue0() == 5);
+    ASSERT(b->ReadSingle(2).GetValue0() == 9);
+  }
+  {
+    std::unique_ptr<IntArray> b(IntArray::CreateBank(a.get(), 4, true, 3));
+    ASSERT(b->GetLength() == 3);
+    ASSERT(b->ReadSingle(0).GetValue0() == 9);
+    ASSERT(b->ReadSingle(1).GetValue0() == 0);
+  }
+}
+
+static long GetTimeUsec() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec * 1000000L + tv.tv_usec;
+}
+
+void BenchmarkIntArray() {
+  static const int kLength = 1 << 20;
+  static const int kPasses = 4;
+  int widths[] = {8, 32, 64};
+  for (int width : widths) {
+    iroha::NumericWidth w(false, width);
+    vector<uint64_t> shape;
+    shape.push_back(kLength);
+    std::unique_ptr<IntArray> a(IntArray::Create(w, shape));
+    long start = GetTimeUsec();
+    uint64_t sum = 0;
+    for (int p = 0; p < kPasses; ++p) {
+      iroha::NumericValue v;
+      for (uint64_t i = 0; i < kLength; ++i) {
+        v.SetValue0(i + p);
+        a->WriteSingle(i, w, v);
+      }
+      for (uint64_t i = 0; i < kLength; ++i) {
+        sum += a->ReadSingle(i).GetValue0();
+      }
+    }
+    long usec = GetTimeUsec() - start;
+    double ns = (usec * 1000.0) / ((double)kLength * kPasses * 2);
+    cout << "IntArray uint" << width << "[" << kLength << "]: " << ns
+         << " ns/access (sum=" << sum << ")\n";
+  }
+}
+
 }  // namespace vm
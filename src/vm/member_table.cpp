@@ -0,0 +1,156 @@
+#include "vm/member_table.h"
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace vm {
+
+static std::atomic<unsigned long> member_table_stamp(0);
+
+MemberTable::MemberTable() : num_erased_(0), stamp_(0) { UpdateStamp(); }
+
+MemberTable::MemberTable(const MemberTable &other)
+    : entries_(other.entries_),
+      slots_(other.slots_),
+      num_erased_(other.num_erased_),
+      stamp_(0) {
+  UpdateStamp();
+}
+
+MemberTable &MemberTable::operator=(const MemberTable &other) {
+  entries_ = other.entries_;
+  slots_ = other.slots_;
+  num_erased_ = other.num_erased_;
+  UpdateStamp();
+  return *this;
+}
+
+Value *MemberTable::Find(sym_t name) {
+  int idx = FindIndex(name);
+  if (idx < 0) {
+    return nullptr;
+  }
+  return &entries_[idx].second;
+}
+
+Value *MemberTable::FindOrAdd(sym_t name) {
+  Value *value = Find(name);
+  if (value != nullptr) {
+    return value;
+  }
+  entries_.push_back(std::make_pair(name, Value()));
+  AddIndex(entries_.size() - 1);
+  UpdateStamp();
+  return &entries_.back().second;
+}
+
+void MemberTable::Insert(sym_t name, const Value &value) {
+  if (Find(name) != nullptr) {
+    return;
+  }
+  entries_.push_back(std::make_pair(name, value));
+  AddIndex(entries_.size() - 1);
+  UpdateStamp();
+}
+
+void MemberTable::Erase(sym_t name) {
+  int idx = FindIndex(name);
+  if (idx < 0) {
+    return;
+  }
+  // Keeps the slot, so probing continues over this entry.
+  entries_[idx].first = nullptr;
+  entries_[idx].second = Value();
+  ++num_erased_;
+  if (num_erased_ > 8 && num_erased_ * 2 > (int)entries_.size()) {
+    RemoveErased();
+  }
+  UpdateStamp();
+}
+
+int MemberTable::FindIndex(sym_t name) const {
+  if (slots_.empty() || name == nullptr) {
+    return -1;
+  }
+  size_t mask = slots_.size() - 1;
+  for (size_t s = Hash(name) & mask;; s = (s + 1) & mask) {
+    int idx = slots_[s];
+    if (idx < 0) {
+      return -1;
+    }
+    if (entries_[idx].first == name) {
+      return idx;
+    }
+  }
+}
+
+void MemberTable::AddIndex(int entry_index) {
+  // Keeps the load factor under 1/2.
+  if (entries_.size() * 2 > slots_.size()) {
+    size_t num_slots = slots_.empty() ? 8 : slots_.size() * 2;
+    Rehash(num_slots);
+    return;
+  }
+  size_t mask = slots_.size() - 1;
+  size_t s = Hash(entries_[entry_index].first) & mask;
+  while (slots_[s] >= 0) {
+    s = (s + 1) & mask;
+  }
+  slots_[s] = entry_index;
+}
+
+void MemberTable::Rehash(size_t num_slots) {
+  slots_.assign(num_slots, -1);
+  size_t mask = num_slots - 1;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    sym_t name = entries_[i].first;
+    if (name == nullptr) {
+      continue;
+    }
+    size_t s = Hash(name) & mask;
+    while (slots_[s] >= 0) {
+      s = (s + 1) & mask;
+    }
+    slots_[s] = i;
+  }
+}
+
+void MemberTable::RemoveErased() {
+  std::deque<Entry> entries;
+  for (Entry &e : entries_) {
+    if (e.first != nullptr) {
+      entries.push_back(e);
+    }
+  }
+  entries_.swap(entries);
+  num_erased_ = 0;
+  Rehash(slots_.size());
+}
+
+void MemberTable::UpdateStamp() { stamp_ = ++member_table_stamp; }
+
+size_t MemberTable::Hash(sym_t name) {
+  uintptr_t p = reinterpret_cast<uintptr_t>(name);
+  // Fibonacci hashing. Low bits of pointers are mostly 0.
+  return (p * 11400714819323198485ULL) >> 32;
+}
+
+MemberTable::iterator::iterator(std::deque<Entry> *entries, size_t idx)
+    : entries_(entries), idx_(idx) {
+  SkipErased();
+}
+
+MemberTable::iterator &MemberTable::iterator::operator++() {
+  ++idx_;
+  SkipErased();
+  return *this;
+}
+
+void MemberTable::iterator::SkipErased() {
+  while (idx_ < entries_->size() && (*entries_)[idx_].first == nullptr) {
+    ++idx_;
+  }
+}
+
+}  // namespace vm
@@ -0,0 +1,75 @@
+// -*- C++ -*-
+#ifndef _vm_member_table_h_
+#define _vm_member_table_h_
+
+#include <deque>
+
+#include "vm/common.h"
+#include "vm/value.h"
+
+namespace vm {
+
+// Members of an Object.
+//
+// Entries are kept in insertion order in a deque so Value* returned
+// by Find() stay valid while other members are added. An open
+// addressing index of entry numbers is used for lookups.
+// Erased entries are left as tombstones with nullptr key. They are
+// removed when they become more than the live entries, so a pointer from
+// Find() is invalidated by Erase().
+class MemberTable {
+ public:
+  typedef std::pair<sym_t, Value> Entry;
+
+  MemberTable();
+  MemberTable(const MemberTable &other);
+  MemberTable &operator=(const MemberTable &other);
+
+  Value *Find(sym_t name);
+  // Returns the existing value or a newly added empty value.
+  Value *FindOrAdd(sym_t name);
+  // Doesn't overwrite an existing value (same as std::map::insert()).
+  void Insert(sym_t name, const Value &value);
+  void Erase(sym_t name);
+
+  // Changes when a member is added or erased. Unique among all the tables,
+  // so (table, stamp) can be used as a key of inline caches.
+  unsigned long GetStamp() const { return stamp_; }
+  // Including tombstones.
+  size_t GetNumEntries() const { return entries_.size(); }
+
+  class iterator {
+   public:
+    iterator(std::deque<Entry> *entries, size_t idx);
+    Entry &operator*() { return (*entries_)[idx_]; }
+    Entry *operator->() { return &(*entries_)[idx_]; }
+    iterator &operator++();
+    bool operator!=(const iterator &other) const { return idx_ != other.idx_; }
+
+   private:
+    void SkipErased();
+
+    std::deque<Entry> *entries_;
+    size_t idx_;
+  };
+  iterator begin() { return iterator(&entries_, 0); }
+  iterator end() { return iterator(&entries_, entries_.size()); }
+
+ private:
+  int FindIndex(sym_t name) const;
+  void AddIndex(int entry_index);
+  void Rehash(size_t num_slots);
+  void RemoveErased();
+  void UpdateStamp();
+  static size_t Hash(sym_t name);
+
+  std::deque<Entry> entries_;
+  // Indexes to entries_. -1 for an empty slot. Size is a power of 2.
+  vector<int> slots_;
+  int num_erased_;
+  unsigned long stamp_;
+};
+
+}  // namespace vm
+
+#endif  // _vm_member_table_h_
@@ -0,0 +1,119 @@
+#include "vm/member_table.h"
+
+#include <set>
+
+#include "iroha/test_util.h"
+
+namespace vm {
+
+static Value NumValue(uint64_t n) {
+  Value value;
+  value.type_ = Value::NUM;
+  value.num_value_.SetValue0(n);
+  return value;
+}
+
+static sym_t MemberName(int i) {
+  return sym_append_idx(sym_lookup("member"), i);
+}
+
+void TestMemberTable() {
+  // Enough to grow the index a few times.
+  const int kNumMembers = 100;
+  MemberTable table;
+  ASSERT(table.Find(MemberName(0)) == nullptr);
+  ASSERT(!(table.begin() != table.end()));
+  for (int i = 0; i < kNumMembers; ++i) {
+    table.Insert(MemberName(i), NumValue(i));
+  }
+  for (int i = 0; i < kNumMembers; ++i) {
+    Value *value = table.Find(MemberName(i));
+    ASSERT(value != nullptr);
+    ASSERT(value->num_value_.GetValue0() == (uint64_t)i);
+  }
+  ASSERT(table.Find(MemberName(kNumMembers)) == nullptr);
+  ASSERT(table.Find(nullptr) == nullptr);
+
+  // Insert() doesn't overwrite and FindOrAdd() returns the existing value.
+  unsigned long stamp = table.GetStamp();
+  table.Insert(MemberName(1), NumValue(100));
+  ASSERT(table.Find(MemberName(1))->num_value_.GetValue0() == 1);
+  ASSERT(table.FindOrAdd(MemberName(2))->num_value_.GetValue0() == 2);
+  ASSERT(table.GetStamp() == stamp);
+
+  // Values stay valid while other members are added.
+  Value *v0 = table.Find(MemberName(0));
+  Value *added = table.FindOrAdd(MemberName(kNumMembers));
+  ASSERT(added->type_ == Value::NONE);
+  ASSERT(table.GetStamp() != stamp);
+  for (int i = kNumMembers + 1; i < kNumMembers * 4; ++i) {
+    table.Insert(MemberName(i), NumValue(i));
+  }
+  ASSERT(table.Find(MemberName(0)) == v0);
+  ASSERT(table.Find(MemberName(kNumMembers)) == added);
+
+  // Iteration is in the insertion order.
+  int n = 0;
+  for (auto &it : table) {
+    ASSERT(it.first == MemberName(n));
+    ++n;
+  }
+  ASSERT(n == kNumMembers * 4);
+
+  // Erased members are skipped and the others are still found over them.
+  stamp = table.GetStamp();
+  for (int i = 0; i < kNumMembers * 4; i += 2) {
+    table.Erase(MemberName(i));
+  }
+  ASSERT(table.GetStamp() != stamp);
+  for (int i = 0; i < kNumMembers * 4; ++i) {
+    ASSERT((table.Find(MemberName(i)) == nullptr) == (i % 2 == 0));
+  }
+  n = 1;
+  for (auto &it : table) {
+    ASSERT(it.first == MemberName(n));
+    n += 2;
+  }
+  ASSERT(n == kNumMembers * 4 + 1);
+  // Added again at the end.
+  table.Insert(MemberName(0), NumValue(7));
+  ASSERT(table.Find(MemberName(0))->num_value_.GetValue0() == 7);
+  sym_t last = nullptr;
+  for (auto &it : table) {
+    last = it.first;
+  }
+  ASSERT(last == MemberName(0));
+
+  // Copies have their own entries and stamp.
+  MemberTable copy(table);
+  ASSERT(copy.GetStamp() != table.GetStamp());
+  ASSERT(copy.Find(MemberName(1)) != table.Find(MemberName(1)));
+  ASSERT(copy.Find(MemberName(1))->num_value_.GetValue0() == 1);
+  copy.Erase(MemberName(1));
+  ASSERT(copy.Find(MemberName(1)) == nullptr);
+  ASSERT(table.Find(MemberName(1)) != nullptr);
+  std::set<sym_t> names;
+  for (auto &it : copy) {
+    names.insert(it.first);
+  }
+  ASSERT(names.size() == kNumMembers * 2);
+
+  // Tombstones of churning members are reclaimed.
+  MemberTable churn;
+  churn.Insert(MemberName(0), NumValue(0));
+  for (int i = 1; i < kNumMembers * 4; ++i) {
+    churn.Insert(MemberName(i), NumValue(i));
+    churn.Erase(MemberName(i));
+  }
+  ASSERT(churn.GetNumEntries() < 20);
+  ASSERT(churn.Find(MemberName(0))->num_value_.GetValue0() == 0);
+  ASSERT(churn.Find(MemberName(1)) == nullptr);
+  n = 0;
+  for (auto &it : churn) {
+    ASSERT(it.first == MemberName(0));
+    ++n;
+  }
+  ASSERT(n == 1);
+}
+
+}  // namespace vm
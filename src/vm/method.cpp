@@ -1,25 +1,23 @@
 #include "vm/method.h"
 
 #include "base/dump_stream.h"
-#include "base/stl_util.h"
 #include "fe/method.h"
 #include "fe/var_decl.h"
 #include "karuta/annotation.h"
+#include "vm/executor/threaded.h"
 #include "vm/insn.h"
 
 namespace vm {
 
 Method::Method(bool is_toplevel)
-    : is_toplevel_(is_toplevel),
+    : arena_(4 * 1024),
+      is_toplevel_(is_toplevel),
       method_fn_(nullptr),
       parse_tree_(nullptr),
       alt_impl_(nullptr),
       compile_failed_(false) {}
 
-Method::~Method() {
-  STLDeleteValues(&insns_);
-  STLDeleteValues(&method_regs_);
-}
+Method::~Method() {}
 
 Method::method_func Method::GetMethodFunc() const { return method_fn_; }
 
@@ -117,4 +115,16 @@ bool Method::IsThreadEntry() const {
   return false;
 }
 
+executor::DecodedMethod *Method::GetDecodedMethod() const {
+  return decoded_.get();
+}
+
+void Method::SetDecodedMethod(executor::DecodedMethod *dm) {
+  decoded_.reset(dm);
+}
+
+Insn *Method::NewInsn() { return arena_.New<Insn>(); }
+
+Register *Method::NewRegister() { return arena_.New<Register>(); }
+
 }  // namespace vm
@@ -2,6 +2,7 @@
 #ifndef _vm_method_h_
 #define _vm_method_h_
 
+#include "base/arena.h"
 #include "vm/common.h"
 #include "vm/register.h"  // for RegisterType
 
@@ -35,6 +36,12 @@ class Method {
   void SetCompileFailure();
   bool IsCompileFailure() const;
   bool IsThreadEntry() const;
+  // Built by executor::Threaded on the first execution.
+  executor::DecodedMethod *GetDecodedMethod() const;
+  void SetDecodedMethod(executor::DecodedMethod *dm);
+  // Insns and registers are owned by the arena of this method.
+  Insn *NewInsn();
+  Register *NewRegister();
 
   vector<Insn *> insns_;
   // Args. Returns. Locals.
@@ -42,6 +49,7 @@ class Method {
   vector<RegisterType> return_types_;
 
  private:
+  Arena arena_;
   bool is_toplevel_;
   // native
   method_func method_fn_;
@@ -50,6 +58,7 @@ class Method {
   const char *alt_impl_;
   string synth_name_;
   bool compile_failed_;
+  std::unique_ptr<executor::DecodedMethod> decoded_;
 };
 
 }  // namespace vm
@@ -12,10 +12,15 @@ class MethodFrame {
   size_t pc_;
   Object *obj_;
   // These values don't hold type information like .value_type and .num_type.
-  vector<Value> reg_values_;
+  // Allocated by FrameStack.
+  Value *reg_values_;
+  size_t num_regs_;
   // callee writes here.
   vector<Value> returns_;
   vector<Object *> objs_;
+  // Allocation point of FrameStack before this frame.
+  size_t saved_chunk_index_;
+  size_t saved_chunk_top_;
 };
 
 }  // namespace vm
@@ -10,6 +10,7 @@
 #include "synth/object_attr_names.h"
 #include "synth/object_method_names.h"
 #include "synth/synth.h"
+#include "vm/gc.h"
 #include "vm/method.h"
 #include "vm/object.h"
 #include "vm/object_util.h"
@@ -139,8 +140,7 @@ void NativeMethods::Compile(Thread *thr, Object *obj,
     phase = StringWrapper::String(args[0].object_);
   }
   if (phase.empty()) {
-    bool ok =
-        synth::Synth::Synthesize(thr->GetVM(), obj, synth::Synth::IrPath(obj));
+    bool ok = synth::Synth::Compile(thr->GetVM(), obj);
     if (!ok) {
       Status::os(Status::USER_ERROR) << "Failed to synthesize the design.";
       thr->UserError();
@@ -228,6 +228,38 @@ void NativeMethods::GC(Thread *thr, Object *obj, const vector<Value> &args) {
   thr->GetVM()->GC();
 }
 
+void NativeMethods::FullGC(Thread *thr, Object *obj,
+                           const vector<Value> &args) {
+  thr->GetVM()->FullGC();
+}
+
+void NativeMethods::GCLiveCount(Thread *thr, Object *obj,
+                                const vector<Value> &args) {
+  Value value;
+  value.type_ = Value::NUM;
+  iroha::Op::MakeConst0(thr->GetVM()->GetGCStats().num_live_,
+                        &value.num_value_);
+  SetReturnValue(thr, value);
+}
+
+void NativeMethods::GCFreedCount(Thread *thr, Object *obj,
+                                 const vector<Value> &args) {
+  Value value;
+  value.type_ = Value::NUM;
+  iroha::Op::MakeConst0(thr->GetVM()->GetGCStats().num_freed_,
+                        &value.num_value_);
+  SetReturnValue(thr, value);
+}
+
+void NativeMethods::GCPauseUsec(Thread *thr, Object *obj,
+                                const vector<Value> &args) {
+  Value value;
+  value.type_ = Value::NUM;
+  iroha::Op::MakeConst0(thr->GetVM()->GetGCStats().pause_usec_,
+                        &value.num_value_);
+  SetReturnValue(thr, value);
+}
+
 void NativeMethods::ClearProfile(Thread *thr, Object *obj,
                                  const vector<Value> &args) {
   thr->GetVM()->GetProfile()->Clear();
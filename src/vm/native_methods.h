@@ -37,6 +37,10 @@ class NativeMethods {
   // Env.
   static void IsMain(Thread *thr, Object *obj, const vector<Value> &args);
   static void GC(Thread *thr, Object *obj, const vector<Value> &args);
+  static void FullGC(Thread *thr, Object *obj, const vector<Value> &args);
+  static void GCLiveCount(Thread *thr, Object *obj, const vector<Value> &args);
+  static void GCFreedCount(Thread *thr, Object *obj, const vector<Value> &args);
+  static void GCPauseUsec(Thread *thr, Object *obj, const vector<Value> &args);
   static void ClearProfile(Thread *thr, Object *obj, const vector<Value> &args);
   static void EnableProfile(Thread *thr, Object *obj,
                             const vector<Value> &args);
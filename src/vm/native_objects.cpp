@@ -74,6 +74,7 @@ Method *NativeObjects::InstallNativeMethod(
 void NativeObjects::InstallEnvNativeMethods(VM *vm, Object *env) {
   vector<RegisterType> rets;
   InstallNativeMethod(vm, env, "gc", &NativeMethods::GC, rets);
+  InstallNativeMethod(vm, env, "fullGc", &NativeMethods::FullGC, rets);
   InstallNativeMethod(vm, env, "clearProfile", &NativeMethods::ClearProfile,
                       rets);
   InstallNativeMethod(vm, env, "enableProfile", &NativeMethods::EnableProfile,
@@ -83,6 +84,14 @@ void NativeObjects::InstallEnvNativeMethods(VM *vm, Object *env) {
   rets.push_back(BoolType(vm));
   InstallNativeMethod(vm, env, "isMain", &NativeMethods::IsMain, rets);
   rets.clear();
+  rets.push_back(IntType(64));
+  InstallNativeMethod(vm, env, "gcLiveCount", &NativeMethods::GCLiveCount,
+                      rets);
+  InstallNativeMethod(vm, env, "gcFreedCount", &NativeMethods::GCFreedCount,
+                      rets);
+  InstallNativeMethod(vm, env, "gcPauseUsec", &NativeMethods::GCPauseUsec,
+                      rets);
+  rets.clear();
   rets.push_back(ObjectType());
   InstallNativeMethod(vm, env, "newTicker", &NativeMethods::GetTicker, rets);
 }
@@ -22,7 +22,7 @@ void Object::Dump() {
   Dump(ds);
 }
 
-Object::Object(VM *vm) : vm_(vm) {}
+Object::Object(VM *vm) : gc_epoch_(0), vm_(vm) {}
 
 const char *Object::ObjectTypeKey() {
   if (object_specific_.get()) {
@@ -47,18 +47,14 @@ void Object::Dump(DumpStream &ds) {
 VM *Object::GetVM() { return vm_; }
 
 void Object::InstallValue(sym_t name, const Value &value) {
-  members_.insert(std::make_pair(name, value));
+  members_.Insert(name, value);
 }
 
 Value *Object::LookupValue(sym_t name, bool cr) {
-  map<sym_t, Value>::iterator it = members_.find(name);
-  if (it != members_.end()) {
-    return &it->second;
+  if (cr) {
+    return members_.FindOrAdd(name);
   }
-  if (!cr) {
-    return nullptr;
-  }
-  return &(members_[name]);
+  return members_.Find(name);
 }
 
 void Object::LookupMemberNames(Object *obj, vector<sym_t> *slots) {
@@ -5,6 +5,7 @@
 #include <map>
 
 #include "vm/common.h"
+#include "vm/member_table.h"
 #include "vm/value.h"
 
 using std::map;
@@ -41,10 +42,13 @@ class Object {
   // Object type specific GC hook.
   void Scan(GC *gc);
 
-  map<sym_t, Value> members_;
+  MemberTable members_;
 
   std::unique_ptr<ObjectSpecificData> object_specific_;
 
+  // Set by the GC when this object is reachable.
+  unsigned int gc_epoch_;
+
  private:
   VM *vm_;
 };
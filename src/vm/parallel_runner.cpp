@@ -0,0 +1,93 @@
+#include "vm/parallel_runner.h"
+
+#include "vm/thread.h"
+
+namespace vm {
+
+ParallelRunner::ParallelRunner(int num_workers)
+    : num_partitions_(num_workers),
+      generation_(0),
+      num_running_(0),
+      exit_(false) {
+  // The calling thread works for the partition 0.
+  for (int i = 1; i < num_partitions_; ++i) {
+    workers_.push_back(std::thread(&ParallelRunner::WorkerMain, this, i));
+  }
+}
+
+ParallelRunner::~ParallelRunner() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    exit_ = true;
+  }
+  start_cv_.notify_all();
+  for (std::thread &w : workers_) {
+    w.join();
+  }
+}
+
+void ParallelRunner::RunPass(const vector<Thread *> &threads) {
+  active_.clear();
+  for (Thread *thr : threads) {
+    if (thr->IsRunnable()) {
+      thr->PrepareLocalRun();
+      active_.push_back(thr);
+    }
+  }
+  RunLocalPhase();
+  // Local insns don't depend on other threads, so running the rest of the
+  // pass in the order of serials gives the same result as the serial
+  // scheduler.
+  for (Thread *thr : active_) {
+    if (thr->IsRunnable()) {
+      thr->Run();
+    }
+  }
+}
+
+void ParallelRunner::RunLocalPhase() {
+  if (active_.size() < 2 || workers_.empty()) {
+    for (Thread *thr : active_) {
+      thr->RunLocal();
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    ++generation_;
+    num_running_ = workers_.size();
+  }
+  start_cv_.notify_all();
+  RunPartition(0);
+  std::unique_lock<std::mutex> lock(mu_);
+  done_cv_.wait(lock, [this] { return num_running_ == 0; });
+}
+
+void ParallelRunner::RunPartition(int idx) {
+  for (size_t i = idx; i < active_.size(); i += num_partitions_) {
+    active_[i]->RunLocal();
+  }
+}
+
+void ParallelRunner::WorkerMain(int idx) {
+  int generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      start_cv_.wait(lock,
+                     [&] { return exit_ || generation_ != generation; });
+      if (exit_) {
+        return;
+      }
+      generation = generation_;
+    }
+    RunPartition(idx);
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      --num_running_;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+}  // namespace vm
@@ -0,0 +1,53 @@
+// -*- C++ -*-
+#ifndef _vm_parallel_runner_h_
+#define _vm_parallel_runner_h_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "vm/common.h"
+
+namespace vm {
+
+// Runs a pass of runnable threads with worker OS threads.
+//
+// At the beginning of a pass, every runnable thread runs its local insns
+// (see DecodedInsn::is_local_) in parallel until it reaches an insn
+// touching objects, channels, arrays and so on. Then each thread runs
+// the rest of the pass until it yields or blocks on the calling thread in
+// the order of thread serials. Local insns don't interfere with other
+// threads, so the result is same as the serial scheduler regardless of
+// the number of workers. Workers synchronize once per pass.
+//
+// Only the local prefix of each pass runs in parallel. OP_YIELD and any
+// access to channels, arrays or members end it, so threads which do such
+// accesses early in each iteration of their loops barely benefit.
+class ParallelRunner {
+ public:
+  ParallelRunner(int num_workers);
+  ~ParallelRunner();
+
+  // threads are sorted by their serials.
+  void RunPass(const vector<Thread *> &threads);
+
+ private:
+  void RunLocalPhase();
+  void RunPartition(int idx);
+  void WorkerMain(int idx);
+
+  int num_partitions_;
+  vector<std::thread> workers_;
+  std::mutex mu_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  // Incremented to start a local phase.
+  int generation_;
+  int num_running_;
+  bool exit_;
+  vector<Thread *> active_;
+};
+
+}  // namespace vm
+
+#endif  // _vm_parallel_runner_h_
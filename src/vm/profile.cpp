@@ -1,10 +1,16 @@
 #include "vm/profile.h"
 
+#include <algorithm>
+#include <fstream>
 #include <map>
-#include <tuple>
+
+#include "fe/method.h"
+#include "karuta/env.h"
+#include "vm/method.h"
+#include "vm/method_frame.h"
+#include "vm/thread.h"
 
 using std::map;
-using std::tuple;
 
 namespace vm {
 
@@ -12,10 +18,17 @@ class ProfileData {
  public:
   ~ProfileData() {}
 
-  map<tuple<Method *, int>, int> count_;
+  map<Method *, vector<long> > count_;
+  // Methods from the bottom of the stack and pc of the top frame.
+  map<std::pair<vector<Method *>, int>, long> stacks_;
+  map<int, ChannelProfile> channels_;
 };
 
-Profile::Profile() : enabled_(false), has_info_(false) {
+Profile::Profile()
+    : enabled_(false),
+      has_info_(false),
+      sample_period_(0),
+      sample_countdown_(0) {
   data_.reset(new ProfileData);
 }
 
@@ -26,24 +39,114 @@ bool Profile::IsEnabled() const { return enabled_; }
 void Profile::SetEnable(bool enable) { enabled_ = enable; }
 
 void Profile::Clear() {
-  data_->count_.clear();
+  // Keeps the arrays, since running methods may hold them.
+  for (auto &it : data_->count_) {
+    vector<long> &counters = it.second;
+    std::fill(counters.begin(), counters.end(), 0);
+  }
+  data_->stacks_.clear();
+  data_->channels_.clear();
   has_info_ = false;
 }
 
-void Profile::Mark(Method *method, int pc) {
-  // For now this doesn't consider multiple inlined instances of a
-  // same method. Probably I might change to store current trace or
-  // whole the stack.
-  auto k = std::make_tuple(method, pc);
-  ++(data_->count_[k]);
-  has_info_ = true;
+long *Profile::GetCounters(Method *method) {
+  vector<long> &counters = data_->count_[method];
+  if (counters.size() < method->insns_.size()) {
+    counters.resize(method->insns_.size(), 0);
+  }
+  return counters.data();
 }
 
 int Profile::GetCount(Method *method, int pc) {
-  auto k = std::make_tuple(method, pc);
-  return data_->count_[k];
+  auto it = data_->count_.find(method);
+  if (it == data_->count_.end()) {
+    return 0;
+  }
+  const vector<long> &counters = it->second;
+  if (pc < 0 || pc >= (int)counters.size()) {
+    return 0;
+  }
+  return counters[pc];
 }
 
 bool Profile::HasInfo() { return has_info_; }
 
+bool Profile::HasChannelInfo() { return !data_->channels_.empty(); }
+
+void Profile::MarkChannelWrite(int id, int occupancy) {
+  ChannelProfile &cp = data_->channels_[id];
+  ++cp.writes_;
+  if (occupancy > cp.max_occupancy_) {
+    cp.max_occupancy_ = occupancy;
+  }
+}
+
+void Profile::MarkChannelBlock(int id, bool is_write) {
+  ChannelProfile &cp = data_->channels_[id];
+  if (is_write) {
+    ++cp.full_;
+  } else {
+    ++cp.empty_;
+  }
+}
+
+bool Profile::GetChannelProfile(int id, ChannelProfile *cp) {
+  auto it = data_->channels_.find(id);
+  if (it == data_->channels_.end()) {
+    return false;
+  }
+  *cp = it->second;
+  return true;
+}
+
+void Profile::SetSamplePeriod(int period) {
+  sample_period_ = period;
+  sample_countdown_ = period;
+}
+
+void Profile::SampleStack(Thread *thr, int pc) {
+  sample_countdown_ = sample_period_;
+  vector<Method *> methods;
+  for (MethodFrame *frame : thr->MethodStack()) {
+    methods.push_back(frame->method_);
+  }
+  ++data_->stacks_[std::make_pair(methods, pc)];
+}
+
+static string MethodName(Method *method) {
+  const fe::Method *parse_tree = method->GetParseTree();
+  if (method->IsTopLevel() || parse_tree == nullptr) {
+    return "(toplevel)";
+  }
+  const string &name = parse_tree->GetName();
+  if (name.empty()) {
+    return "(anonymous)";
+  }
+  return name;
+}
+
+bool Profile::WriteCollapsedStacks(const string &fn) {
+  string path;
+  if (!Env::GetOutputPath(fn.c_str(), &path)) {
+    return false;
+  }
+  std::ofstream os(path);
+  if (!os) {
+    return false;
+  }
+  for (auto &it : data_->stacks_) {
+    const vector<Method *> &methods = it.first.first;
+    for (size_t i = 0; i < methods.size(); ++i) {
+      if (i > 0) {
+        os << ";";
+      }
+      os << MethodName(methods[i]);
+    }
+    // pc in the top frame.
+    os << ";" << MethodName(methods.back()) << ":" << it.first.second << " "
+       << it.second << "\n";
+  }
+  return true;
+}
+
 }  // namespace vm
@@ -8,21 +8,67 @@ namespace vm {
 
 class ProfileData;
 
+// Activity of a channel while the profile is enabled.
+class ChannelProfile {
+ public:
+  ChannelProfile() : writes_(0), max_occupancy_(0), full_(0), empty_(0) {}
+
+  long writes_;
+  // Max number of values in the channel after a write.
+  int max_occupancy_;
+  // Number of writes blocked by a full channel.
+  long full_;
+  // Number of reads blocked by an empty channel.
+  long empty_;
+};
+
+// Counts executions of each insn in dense per method arrays indexed by
+// pc and activities of each channel. Optionally samples the call stack of
+// the running thread every N insns, so that the hot paths can be exported
+// in the collapsed stack format (one "frame;frame;...;frame count" per
+// line) which flamegraph.pl, speedscope and pprof can read.
 class Profile {
  public:
   Profile();
   ~Profile();
 
-  void Mark(Method *method, int pc);
+  // Returns the counter array of the method. The array stays valid
+  // even after Clear().
+  long *GetCounters(Method *method);
+  // Counts an execution of the insn at pc. counters is from GetCounters().
+  void Mark(Thread *thr, long *counters, int pc) {
+    ++counters[pc];
+    has_info_ = true;
+    if (sample_period_ > 0 && --sample_countdown_ == 0) {
+      SampleStack(thr, pc);
+    }
+  }
   int GetCount(Method *method, int pc);
   bool IsEnabled() const;
   void SetEnable(bool enable);
   void Clear();
+  // true if an insn is counted.
   bool HasInfo();
+  // true if a channel is accessed.
+  bool HasChannelInfo();
+  // 0 to disable the call stack sampling.
+  void SetSamplePeriod(int period);
+  bool WriteCollapsedStacks(const string &fn);
+  // Called by ChannelWrapper. occupancy is after the write.
+  // Channels are keyed by ChannelWrapper::ChannelId() instead of the
+  // objects, since the objects can be collected and the addresses reused.
+  void MarkChannelWrite(int id, int occupancy);
+  void MarkChannelBlock(int id, bool is_write);
+  // Returns false if the channel isn't accessed while profiling.
+  bool GetChannelProfile(int id, ChannelProfile *cp);
 
  private:
+  void SampleStack(Thread *thr, int pc);
+
   bool enabled_;
   bool has_info_;
+  int sample_period_;
+  int sample_countdown_;
   std::unique_ptr<ProfileData> data_;
 };
 
@@ -0,0 +1,44 @@
+#include "vm/profile.h"
+
+#include "base/sym.h"
+#include "iroha/test_util.h"
+#include "vm/channel_wrapper.h"
+#include "vm/vm.h"
+
+namespace vm {
+
+void TestProfile() {
+  // Channels declared with the same name in different objects.
+  VM vm;
+  Object *a = ChannelWrapper::NewChannel(&vm, 32, sym_lookup("c"), nullptr);
+  Object *b = ChannelWrapper::NewChannel(&vm, 32, sym_lookup("c"), nullptr);
+  int a_id = ChannelWrapper::ChannelId(a);
+  int b_id = ChannelWrapper::ChannelId(b);
+  ASSERT(a_id != b_id);
+
+  Profile profile;
+  ASSERT(!profile.HasChannelInfo());
+  profile.MarkChannelWrite(a_id, 1);
+  profile.MarkChannelWrite(a_id, 3);
+  profile.MarkChannelWrite(a_id, 2);
+  profile.MarkChannelBlock(a_id, true);
+  profile.MarkChannelBlock(b_id, false);
+  profile.MarkChannelBlock(b_id, false);
+  ASSERT(profile.HasChannelInfo());
+  // Channel marks aren't insn counts.
+  ASSERT(!profile.HasInfo());
+
+  ChannelProfile cp;
+  ASSERT(profile.GetChannelProfile(a_id, &cp));
+  ASSERT(cp.writes_ == 3 && cp.max_occupancy_ == 3);
+  ASSERT(cp.full_ == 1 && cp.empty_ == 0);
+  ASSERT(profile.GetChannelProfile(b_id, &cp));
+  ASSERT(cp.writes_ == 0 && cp.max_occupancy_ == 0);
+  ASSERT(cp.full_ == 0 && cp.empty_ == 2);
+
+  profile.Clear();
+  ASSERT(!profile.HasChannelInfo());
+  ASSERT(!profile.GetChannelProfile(a_id, &cp));
+}
+
+}  // namespace vm
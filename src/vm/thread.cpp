@@ -6,6 +6,8 @@
 #include "fe/var_decl.h"
 #include "karuta/env.h"
 #include "vm/executor/executor.h"
+#include "vm/executor/threaded.h"
+#include "vm/frame_stack.h"
 #include "vm/insn.h"
 #include "vm/method.h"
 #include "vm/object.h"
@@ -22,7 +24,9 @@ Thread::Thread(VM *vm, Thread *parent, Object *obj, Method *method, int index)
       parent_thread_(parent),
       in_yield_(false),
       index_(index),
-      busy_counter_(0) {
+      serial_(0),
+      busy_counter_(0),
+      frame_stack_(new FrameStack) {
   stat_ = RUNNABLE;
   PushMethodFrame(obj, method);
   MaySetThreadIndex();
@@ -53,19 +57,35 @@ void Thread::Run() {
 void Thread::RunMethod() {
   MethodFrame *frame = CurrentMethodFrame();
   Method *method = frame->method_;
-  executor::Executor executor(this, frame);
   Profile *profile = vm_->GetProfile();
   bool profile_enabled = profile->IsEnabled();
-  while (frame->pc_ < method->insns_.size()) {
+  if (Env::GetThreadedVM() && !method->IsTopLevel()) {
+    executor::Threaded threaded(this, frame);
+    if (threaded.Run(profile_enabled ? profile : nullptr)) {
+      return;
+    }
+  } else {
+    executor::Executor executor(this, frame);
+    long *counters = nullptr;
     if (profile_enabled) {
-      profile->Mark(method, frame->pc_);
+      counters = profile->GetCounters(method);
     }
-    Insn *insn = method->insns_[frame->pc_];
-    bool need_suspend = executor.ExecInsn(insn);
-    if (need_suspend) {
-      return;
+    while (frame->pc_ < method->insns_.size()) {
+      if (counters != nullptr) {
+        profile->Mark(this, counters, frame->pc_);
+      }
+      Insn *insn = method->insns_[frame->pc_];
+      bool need_suspend = executor.ExecInsn(insn);
+      if (need_suspend) {
+        return;
+      }
     }
   }
+  FinishMethod();
+}
+
+void Thread::FinishMethod() {
+  Method *method = CurrentMethodFrame()->method_;
   PassReturnValues();
   if (ByteCodeDebugMode::IsEnabled(dbg_bytecode_)) {
     // debug run time annotating.
@@ -78,6 +98,22 @@ void Thread::RunMethod() {
   PopMethodFrame();
 }
 
+void Thread::PrepareLocalRun() {
+  Method *method = CurrentMethodFrame()->method_;
+  if (!method->IsTopLevel()) {
+    executor::Threaded::Prepare(method);
+  }
+}
+
+void Thread::RunLocal() {
+  MethodFrame *frame = CurrentMethodFrame();
+  if (frame->method_->IsTopLevel()) {
+    return;
+  }
+  executor::Threaded threaded(this, frame);
+  threaded.RunLocal();
+}
+
 void Thread::Dump() const {
   DumpStream ds(cout);
   Dump(ds);
@@ -103,6 +139,7 @@ void Thread::Exit() { stat_ = DONE; }
 void Thread::Resume() {
   CHECK(stat_ == SUSPENDED);
   stat_ = RUNNABLE;
+  vm_->AddReadyThread(this);
 }
 
 bool Thread::Yield() {
@@ -151,21 +188,14 @@ bool Thread::OnJump() {
   return false;
 }
 
+bool Thread::CanJumpLocally() const {
+  return (busy_counter_limit_ <= 0 || busy_counter_ < busy_counter_limit_);
+}
+
 void Thread::MayBlock() { busy_counter_ = 0; }
 
 MethodFrame *Thread::PushMethodFrame(Object *obj, Method *method) {
-  MethodFrame *frame = new MethodFrame;
-  frame->method_ = method;
-  frame->pc_ = 0;
-  frame->obj_ = obj;
-  frame->reg_values_.resize(method->method_regs_.size());
-  for (size_t i = 0; i < method->method_regs_.size(); ++i) {
-    Value &local_val = frame->reg_values_[i];
-    Register *reg = method->method_regs_[i];
-    local_val.type_ = reg->type_.value_type_;
-    local_val.enum_val_.enum_type = reg->type_.enum_type_;
-    local_val.num_width_ = reg->type_.num_width_;
-  }
+  MethodFrame *frame = frame_stack_->Push(obj, method);
   method_stack_.push_back(frame);
   return frame;
 }
@@ -195,9 +225,8 @@ void Thread::PassReturnValues() {
 void Thread::PopMethodFrame() {
   CHECK(method_stack_.size() > 0)
       << "attempting to pop from empty method stack.";
-  MethodFrame *frame = CurrentMethodFrame();
   method_stack_.pop_back();
-  delete frame;
+  frame_stack_->Pop();
 }
 
 MethodFrame *Thread::CurrentMethodFrame() const {
@@ -224,4 +253,8 @@ void Thread::SetModuleName(const string &n) { module_name_ = n; }
 
 const string &Thread::GetModuleName() { return module_name_; }
 
+void Thread::SetSerial(int serial) { serial_ = serial; }
+
+int Thread::GetSerial() const { return serial_; }
+
 }  // namespace vm
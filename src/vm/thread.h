@@ -12,6 +12,12 @@ class Thread {
   ~Thread();
 
   void Run();
+  // For ParallelRunner.
+  // Decodes the current method. Must be called before RunLocal().
+  void PrepareLocalRun();
+  // Runs insns which only touch registers of the current method frame.
+  // Can be called for different threads in parallel.
+  void RunLocal();
   void Dump() const;
   void Dump(DumpStream &ds) const;
   bool IsRunnable() const;
@@ -37,15 +43,22 @@ class Thread {
   // Busy look detection.
   // Consecutive jumps without thread suspend are considered to be a busy loop.
   bool OnJump();
+  // true if OnJump() doesn't detect a busy loop.
+  bool CanJumpLocally() const;
   void MayBlock();
 
   void SetModuleName(const string &n);
   const string &GetModuleName();
 
+  // Creation order in the VM. Used to schedule threads deterministically.
+  void SetSerial(int serial);
+  int GetSerial() const;
+
  private:
   enum Stat { RUNNABLE, SUSPENDED, DONE };
 
   void RunMethod();
+  void FinishMethod();
   void PassReturnValues();
   void PopMethodFrame();
   MethodFrame *CurrentMethodFrame() const;
@@ -61,9 +74,11 @@ class Thread {
   vector<MethodFrame *> method_stack_;
   bool in_yield_;
   int index_;
+  int serial_;
   string module_name_;
   long busy_counter_;
   long busy_counter_limit_;
+  std::unique_ptr<FrameStack> frame_stack_;
 };
 
 }  // namespace vm
@@ -6,7 +6,7 @@ namespace vm {
 
 void ThreadQueue::AddThread(Thread *thr) {
   CHECK(thr->IsRunnable());
-  waiters.insert(thr);
+  waiters.push_back(thr);
   thr->Suspend();
 }
 
@@ -14,9 +14,9 @@ void ThreadQueue::ResumeOne() {
   if (waiters.size() == 0) {
     return;
   }
-  Thread *thr = *(waiters.begin());
+  Thread *thr = waiters.front();
   CHECK(!thr->IsRunnable());
-  waiters.erase(thr);
+  waiters.pop_front();
   thr->Resume();
 }
 
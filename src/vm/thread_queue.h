@@ -2,12 +2,14 @@
 #ifndef _vm_thread_queue_h_
 #define _vm_thread_queue_h_
 
+#include <deque>
 #include <set>
 
 #include "vm/common.h"
 
 namespace vm {
 
+// Waiters are resumed in FIFO order.
 class ThreadQueue {
  public:
   void AddThread(Thread *thr);
@@ -16,7 +18,7 @@ class ThreadQueue {
   bool ClearIfNotified(Thread *thr);
 
  private:
-  std::set<Thread *> waiters;
+  std::deque<Thread *> waiters;
   std::set<Thread *> notified;
 };
 
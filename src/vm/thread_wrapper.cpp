@@ -76,7 +76,7 @@ void ThreadWrapper::DeleteThreadByMethodName(Object *obj, const string &name) {
       continue;
     }
     if (data->entry.method_name == name) {
-      obj->members_.erase(it.first);
+      obj->members_.Erase(it.first);
     }
   }
 }
@@ -1,5 +1,7 @@
 #include "vm/vm.h"
 
+#include <algorithm>
+
 #include "base/status.h"
 #include "base/stl_util.h"
 #include "compiler/compiler.h"
@@ -13,14 +15,20 @@
 #include "vm/native_objects.h"
 #include "vm/object.h"
 #include "vm/opcode.h"
+#include "vm/parallel_runner.h"
 #include "vm/profile.h"
 #include "vm/thread.h"
 
 namespace vm {
 
-VM::VM() : tick_count_(0) {
+VM::VM() : num_old_objects_after_full_(0), gc_epoch_(0), tick_count_(0) {
   methods_.reset(new Pool<Method>());
   profile_.reset(new Profile());
+  if (!Env::GetProfileOutput().empty()) {
+    profile_->SetEnable(true);
+    profile_->SetSamplePeriod(Env::GetProfilePeriod());
+  }
+  gc_stats_.reset(new GCStats());
 
   root_object_ = NewEmptyObject();
   InstallBoolType();
@@ -30,36 +38,72 @@ VM::VM() : tick_count_(0) {
 
 VM::~VM() {
   STLDeleteValues(&threads_);
-  STLDeleteValues(&objects_);
+  STLDeleteValues(&old_objects_);
+  STLDeleteValues(&young_objects_);
 }
 
 void VM::Run() {
-  bool may_continue = true;
   long duration = Env::GetDuration();
   long context_switch_count = 0;
   bool expired = false;
-  while (may_continue) {
-    may_continue = false;
-    for (Thread *thr : threads_) {
-      if (thr->IsRunnable()) {
-        thr->Run();
-        may_continue = true;
+  std::unique_ptr<ParallelRunner> parallel;
+  // To report once.
+  bool parallel_disabled = false;
+  if (Env::GetNumVmWorkers() > 0) {
+    parallel.reset(new ParallelRunner(Env::GetNumVmWorkers()));
+  }
+  vector<Thread *> runnables;
+  while (true) {
+    if (ready_threads_.empty()) {
+      if (yielded_threads_.empty()) {
+        break;
+      }
+      // Resume() puts them to ready_threads_. This counts as a pass and
+      // they run in the next one, as the polling loop did.
+      vector<Thread *> yielded;
+      yielded.swap(yielded_threads_);
+      for (Thread *thr : yielded) {
+        thr->Resume();
+      }
+      context_switch_count++;
+      if (duration > 0 && context_switch_count > duration) {
+        Status::os(Status::INFO) << "Simulation expired";
+        expired = true;
+        break;
+      }
+      continue;
+    }
+    runnables.clear();
+    runnables.swap(ready_threads_);
+    std::sort(runnables.begin(), runnables.end(),
+              [](const Thread *a, const Thread *b) {
+                return a->GetSerial() < b->GetSerial();
+              });
+    bool use_parallel = (parallel.get() != nullptr);
+    if (use_parallel && profile_->IsEnabled()) {
+      // Profile counters aren't thread safe.
+      use_parallel = false;
+      if (!parallel_disabled) {
+        Status::os(Status::INFO)
+            << "--vm_workers is disabled while the profile is enabled";
+        MessageFlush::Get(Status::INFO);
+        parallel_disabled = true;
       }
     }
-    if (!may_continue) {
-      if (yielded_threads_.size() > 0) {
-        for (Thread *thr : yielded_threads_) {
-          thr->Resume();
+    if (use_parallel) {
+      parallel->RunPass(runnables);
+    } else {
+      for (Thread *thr : runnables) {
+        if (thr->IsRunnable()) {
+          thr->Run();
         }
-        yielded_threads_.clear();
-        may_continue = true;
       }
     }
     context_switch_count++;
     if (duration > 0 && context_switch_count > duration) {
       Status::os(Status::INFO) << "Simulation expired";
-      may_continue = false;
       expired = true;
+      break;
     }
   }
 
@@ -78,16 +122,44 @@ Thread *VM::AddThreadFromMethod(Thread *parent, Object *object, Method *method,
                                 int index) {
   compiler::Compiler::CompileMethod(this, object, method);
   Thread *thread = new Thread(this, parent, object, method, index);
-  threads_.insert(thread);
+  thread->SetSerial(threads_.size());
+  threads_.push_back(thread);
+  AddReadyThread(thread);
   return thread;
 }
 
 void VM::Yield(Thread *thr) {
   thr->Suspend();
-  yielded_threads_.insert(thr);
+  yielded_threads_.push_back(thr);
+}
+
+void VM::AddReadyThread(Thread *thr) { ready_threads_.push_back(thr); }
+
+void VM::GC() {
+  // Old objects are swept only when they doubled since the last full GC.
+  bool is_full = (old_objects_.size() > num_old_objects_after_full_ * 2);
+  RunGC(is_full);
+}
+
+void VM::FullGC() { RunGC(true); }
+
+void VM::RunGC(bool is_full) {
+  ++gc_epoch_;
+  if (gc_epoch_ == 0) {
+    // Wrapped around. 0 is the initial value of objects.
+    for (Object *o : old_objects_) {
+      o->gc_epoch_ = 0;
+    }
+    ++gc_epoch_;
+  }
+  GC::Run(this, &threads_, &old_objects_, &young_objects_, gc_epoch_,
+          is_full, gc_stats_.get());
+  if (is_full) {
+    num_old_objects_after_full_ = old_objects_.size();
+  }
 }
 
-void VM::GC() { GC::Run(this, &threads_, &objects_); }
+const GCStats &VM::GetGCStats() const { return *gc_stats_; }
 
 void VM::InstallBoolType() {
   bool_type_ = EnumTypeWrapper::NewEnumTypeWrapper(this, sym_lookup("bool"));
@@ -163,7 +235,7 @@ Method *VM::NewMethod(bool is_toplevel) {
 
 Object *VM::NewEmptyObject() {
   Object *object = new Object(this);
-  objects_.insert(object);
+  young_objects_.push_back(object);
   return object;
 }
 
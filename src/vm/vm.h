@@ -20,7 +20,12 @@ class VM {
   Thread *AddThreadFromMethod(Thread *parent, Object *object, Method *method,
                               int index);
   void Yield(Thread *thr);
+  // Called when a thread becomes runnable.
+  void AddReadyThread(Thread *thr);
+  // Young collection. Full collection when the old objects grew.
   void GC();
+  void FullGC();
+  const GCStats &GetGCStats() const;
   IntArray *GetDefaultMemory();
 
   Method *NewMethod(bool is_toplevel);
@@ -39,17 +44,28 @@ class VM {
   Object *default_mem_;
 
  private:
-  set<Thread *> threads_;
-  set<Thread *> yielded_threads_;
+  // In creation order.
+  vector<Thread *> threads_;
+  vector<Thread *> yielded_threads_;
+  // Runnable threads to be run in the next pass.
+  vector<Thread *> ready_threads_;
 
   std::unique_ptr<Pool<Method> > methods_;
   std::unique_ptr<Profile> profile_;
-  set<Object *> objects_;
+  // Survived a GC.
+  vector<Object *> old_objects_;
+  // Allocated since the last GC.
+  vector<Object *> young_objects_;
+  // Number of old objects after the last full GC.
+  size_t num_old_objects_after_full_;
+  unsigned int gc_epoch_;
+  std::unique_ptr<GCStats> gc_stats_;
 
   unsigned int tick_count_;
 
   void InstallBoolType();
   void InstallObjects();
+  void RunGC(bool is_full);
 };
 
 }  // namespace vm
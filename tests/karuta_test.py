@@ -44,6 +44,17 @@ def CheckLog(fn, exp):
             "done_stat":done_stat}
 
 
+def CountMissingLogs(fn, exps):
+    # Each of exps should match a line of the log.
+    lines = open(fn, "r").readlines()
+    num_fails = 0
+    for exp in exps:
+        if not any(re.search(exp, line) for line in lines):
+            print("Missing log: " + exp)
+            num_fails = num_fails + 1
+    return num_fails
+
+
 def ReadTestInfo(fn):
     test_info = {"exp_fails":0,
                  "vl_exp_fails":0,
@@ -82,6 +93,16 @@ def ReadTestInfo(fn):
         m = re.search("KARUTA_SPLIT_TEST: (\S+)", line)
         if m:
             test_info["split_info"] = m.group(1)
+        m = re.search("KARUTA_EXPECTED_LOG: (.+)", line)
+        if m:
+            if "exp_logs" not in test_info:
+                test_info["exp_logs"] = []
+            test_info["exp_logs"].append(m.group(1).strip())
+        m = re.search("KARUTA_COMPARE_FLAGS: (.+)", line)
+        if m:
+            if "compare_flags" not in test_info:
+                test_info["compare_flags"] = []
+            test_info["compare_flags"].append(m.group(1).strip())
         m = re.search("SELF_SHELL:", line)
         if m:
             test_info["self_shell"] = 1
@@ -148,7 +169,27 @@ def CheckVerilog(dut_fn, source_fn, summary, test_info):
         pass
 
 
-def GetKarutaCommand(source_fn, tf, test_info):
+def ReadPrints(fn):
+    # Outputs of print(), results of assert() and messages (I: and U:).
+    prints = []
+    ifh = open(fn, "r")
+    for line in ifh:
+        if (line.startswith("print") or line.startswith("I:") or
+            line.startswith("U:") or line.startswith("ASSERTION")):
+            prints.append(line)
+    return prints
+
+
+def ReadVerilog(test_info):
+    if "verilog" not in test_info:
+        return None
+    try:
+        return open(tmp_prefix + "/" + test_info["verilog"], "r").read()
+    except:
+        return None
+
+
+def GetKarutaCommand(source_fn, tf, test_info, extra_flags=""):
     vanilla = "--vanilla"
     if "verilog" in test_info:
         # verilog tests requires imported modules.
@@ -163,6 +204,8 @@ def GetKarutaCommand(source_fn, tf, test_info):
     cmd += " --root " + tmp_prefix
     cmd += " --timeout " + timeout + " "
     cmd += " --print_exit_status "
+    if extra_flags:
+        cmd += " " + extra_flags + " "
     if "self_shell" in test_info:
         cmd += " --compile --with_shell "
     else:
@@ -197,6 +240,10 @@ class KarutaTest():
                          summary, test_info)
         res = CheckLog(tf, None)
         num_fails = res["num_fails"]
+        if "exp_logs" in test_info:
+            num_fails += CountMissingLogs(tf, test_info["exp_logs"])
+        if "compare_flags" in test_info:
+            num_fails += self.CompareOutputs(tf, test_info)
         done_stat = res["done_stat"]
         exp_fails = test_info["exp_fails"]
         exp_abort = test_info["exp_abort"]
@@ -205,3 +252,25 @@ class KarutaTest():
                           test_info["karuta_ignore_errors"],
                           done_stat, exp_abort, exp_fails)
         os.unlink(tf)
+
+    def CompareOutputs(self, tf, test_info):
+        # Runs again with each set of flags and compares the prints and
+        # the Verilog output.
+        num_fails = 0
+        prints = ReadPrints(tf)
+        verilog = ReadVerilog(test_info)
+        for flags in test_info["compare_flags"]:
+            ctf = tempfile.mktemp()
+            cmd = GetKarutaCommand(self.source_fn, ctf, test_info, flags)
+            print(" compare command line=" + cmd)
+            if verilog is not None:
+                os.unlink(tmp_prefix + "/" + test_info["verilog"])
+            os.system(cmd)
+            if ReadPrints(ctf) != prints:
+                print("Different output with " + flags)
+                num_fails = num_fails + 1
+            if ReadVerilog(test_info) != verilog:
+                print("Different Verilog output with " + flags)
+                num_fails = num_fails + 1
+            os.unlink(ctf)
+        return num_fails
@@ -0,0 +1,66 @@
+#! /usr/bin/python3
+
+# Measures the synthesis time of generated designs.
+#
+# usage: ./synth_bench.py [num_ops...]
+# Each design has num_ops arithmetic operations over 64 widths and a
+# sub object call per 100 operations. The time should grow linearly.
+
+import os
+import sys
+import tempfile
+import time
+
+karuta_binary = "../karuta-bin"
+ops = ["+", "-", "*", "&", "|", "^"]
+num_widths = 64
+
+
+def Generate(fn, num_ops):
+    ofh = open(fn, "w")
+    num_calls = num_ops // 100
+    for i in range(num_calls):
+        ofh.write("shared Kernel.m%d object = Kernel.clone()\n" % i)
+        ofh.write("shared M%d object = Kernel.m%d\n" % (i, i))
+        ofh.write("func M%d.f(x #32) (#32) {\n" % i)
+        ofh.write("  return x + %d\n" % i)
+        ofh.write("}\n")
+    ofh.write("func Kernel.main() {\n")
+    for w in range(1, num_widths + 1):
+        ofh.write("  var a%d #%d = %d\n" % (w, w, w))
+        ofh.write("  var b%d #%d = 1\n" % (w, w))
+    ofh.write("  var c #32 = 0\n")
+    for i in range(num_ops):
+        w = i % num_widths + 1
+        op = ops[(i // num_widths) % len(ops)]
+        ofh.write("  a%d = a%d %s b%d\n" % (w, w, op, w))
+        if i % 100 == 99:
+            ofh.write("  c = m%d.f(c)\n" % (i // 100))
+    ofh.write("}\n")
+    ofh.write("Kernel.main()\n")
+    ofh.write("Kernel.compile()\n")
+    ofh.close()
+
+
+def Run(num_ops):
+    fn = tempfile.mktemp(suffix=".karuta")
+    Generate(fn, num_ops)
+    cmd = ("KARUTA_DIR=../lib " + karuta_binary + " " + fn +
+           " --vanilla --root " + tempfile.gettempdir() + " > /dev/null")
+    start = time.time()
+    rv = os.system(cmd)
+    elapsed = time.time() - start
+    os.unlink(fn)
+    if rv:
+        print("failed: %d ops" % num_ops)
+        return
+    print("%d ops: %.2f sec (%.1f us/op)" %
+          (num_ops, elapsed, elapsed * 1000000 / num_ops))
+
+
+if __name__ == "__main__":
+    sizes = [int(a) for a in sys.argv[1:]]
+    if not sizes:
+        sizes = [2500, 5000, 10000, 20000]
+    for s in sizes:
+        Run(s)
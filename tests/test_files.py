@@ -10,11 +10,13 @@ default_tests = ["fe_error/misc.karuta",
                  "fe_lang/import_file.karuta", "fe_lang/load.karuta", "fe_lang/for.karuta",
                  "fe_lang/funcall.karuta", "fe_lang/if.karuta", "fe_lang/string.karuta",
                  "fe_lang/decl.karuta", "fe_lang/scope.karuta", "fe_lang/pipe.karuta",
-                 "fe_lang/while.karuta",
+                 "fe_lang/while.karuta", "fe_lang/insn_opt.karuta", "fe_lang/vm_engine.karuta",
+                 "fe_lang/implicit_type.karuta",
                  "fe_misc/errors.karuta", "fe_misc/tb.karuta",
                  "fe_misc/hello.karuta", "fe_misc/parser.karuta",
                  "fe_misc/misc.karuta",
                  "fe_obj/object.karuta", "fe_obj/this_obj.karuta", "fe_obj/thread.karuta",
+                 "fe_obj/gc.karuta", "fe_obj/workers.karuta",
                  "fe_typeobj/basic.karuta",
                  "fe_value/basic.karuta", "fe_value/numeric.karuta",
                  "fe_value/false.karuta", "fe_value/array.karuta",
@@ -32,6 +34,7 @@ default_tests = ["fe_error/misc.karuta",
                  "synth_ext/sram_if_wait.karuta",
                  "synth_shared/channel.karuta",
                  "synth_shared/channel_10w.karuta",
+                 "synth_shared/channel_depth.karuta",
                  "synth_shared/channel_rw.karuta",
                  "synth_shared/mailbox.karuta",
                  "synth_shared/mailbox_10.karuta",